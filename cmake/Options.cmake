@@ -27,6 +27,18 @@ print_option(BUILD_SYSTEM_DRIVER "Build system driver")
 option(INTEGRATIONTEST "Build Integration Tests" OFF)
 print_option(INTEGRATIONTEST "Build Integration Tests")
 
+option(BENCHMARK "Build Host Benchmark" OFF)
+print_option(BENCHMARK "Build Host Benchmark")
+
+option(STATISTICS "Enable Performance Counters" OFF)
+print_option(STATISTICS "Enable Performance Counters")
+
+option(TRACE "Enable Latency Tracing" OFF)
+print_option(TRACE "Enable Latency Tracing")
+
+set(MQTT_PACKET_SIZE 128 CACHE STRING "MQTT Packet Size (bytes)")
+print_option(MQTT_PACKET_SIZE "MQTT Packet Size")
+
 option(SANITIZER_ASAN "Enable ASan" OFF)
 print_option(SANITIZER_ASAN "ASan")
 
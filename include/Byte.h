@@ -42,6 +42,9 @@ namespace eth::byte
     template <class Itr>
     concept ByteCompatibleIterator = is_byte_compatible_itr_v<Itr>;
 
+    template <class Itr>
+    concept ContiguousByteIterator = std::contiguous_iterator<Itr> && std::is_same_v<std::iter_value_t<Itr>, std::uint8_t>;
+
 
     template <std::size_t pos, class T>
         requires IntegralType<T> && IndexWithinTypesize<T, pos>
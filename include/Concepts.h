@@ -21,6 +21,9 @@
 #pragma once
 
 #include <type_traits>
+#include <concepts>
+#include <cstdint>
+#include <span>
 
 namespace eth
 {
@@ -34,4 +37,12 @@ namespace eth
     template <class T, std::size_t index>
     concept IndexWithinTypesize = (index < sizeof(T));
 
+    template <class T>
+    concept Transport = requires(T& t, std::uint16_t address, std::uint8_t data, std::span<const std::uint8_t> source, std::span<std::uint8_t> destination) {
+        t.write(address, data);
+        { t.read(address) } -> std::convertible_to<std::uint8_t>;
+        t.writeBlock(address, source);
+        t.readBlock(address, destination);
+    };
+
 }
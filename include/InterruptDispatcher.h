@@ -0,0 +1,74 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SocketHandle.h"
+#include "SocketInterrupt.h"
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace eth
+{
+    class NetDevice;
+
+
+    class InterruptDispatcher
+    {
+    public:
+        using Event = SocketInterrupt::Mask;
+        using Handler = void (*)(SocketHandle s, Event event, void* context);
+
+
+        explicit InterruptDispatcher(NetDevice& dev);
+        InterruptDispatcher(const InterruptDispatcher&) = delete;
+
+
+        void registerHandler(SocketHandle s, Handler handler, void* context);
+        void unregisterHandler(SocketHandle s);
+
+        void notify();
+        bool isPending() const;
+        std::size_t process();
+
+
+        InterruptDispatcher& operator=(const InterruptDispatcher&) = delete;
+
+
+    private:
+        struct Entry
+        {
+            Handler handler;
+            void* context;
+        };
+
+
+        std::size_t dispatch(SocketHandle s, SocketInterrupt value) const;
+        void updateInterruptMask();
+        std::uint8_t interruptMask() const;
+
+
+        NetDevice& device;
+        std::array<Entry, maxSockets> entries;
+        volatile bool pending;
+    };
+
+}
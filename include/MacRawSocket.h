@@ -0,0 +1,69 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Socket.h"
+#include "SocketHandle.h"
+#include "ReceiveQueue.h"
+#include <cstdint>
+#include <cstddef>
+#include <span>
+
+namespace eth
+{
+    class NetDevice;
+
+
+    class MacRawSocket
+    {
+    public:
+        using Status = Socket::Status;
+        using Result = Socket::Result;
+
+
+        explicit MacRawSocket(NetDevice& dev);
+        MacRawSocket(const MacRawSocket&) = delete;
+        ~MacRawSocket();
+
+
+        Status open(std::uint8_t flag);
+        void close();
+
+        std::uint16_t sendFrame(std::span<const std::uint8_t> frame);
+        Result receiveFrame(std::span<std::uint8_t> buffer);
+        std::size_t receiveFrames(std::span<std::uint8_t> buffer, std::span<std::span<std::uint8_t>> frames);
+
+        SocketStatus getStatus() const;
+
+
+        MacRawSocket& operator=(const MacRawSocket&) = delete;
+
+
+    private:
+        void closeImpl();
+
+
+        SocketHandle handle;
+        NetDevice& device;
+        ReceiveQueue queue;
+    };
+
+}
@@ -0,0 +1,79 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SocketHandle.h"
+#include "SocketCommand.h"
+#include "SocketStatus.h"
+#include "SocketInterrupt.h"
+#include "SocketSnapshot.h"
+#include "NetConfig.h"
+#include <cstdint>
+#include <span>
+
+namespace eth
+{
+
+    class NetDevice
+    {
+    public:
+        virtual ~NetDevice() = default;
+
+
+        virtual std::uint8_t getSocketCount() const noexcept = 0;
+
+        virtual void executeSocketCommand(SocketHandle s, SocketCommand cmd) = 0;
+
+        virtual void writeSocketModeRegister(SocketHandle s, std::uint8_t value) = 0;
+        virtual void writeSocketSourcePort(SocketHandle s, std::uint16_t value) = 0;
+
+        virtual void writeSocketInterruptRegister(SocketHandle s, SocketInterrupt value) = 0;
+        virtual SocketInterrupt readSocketInterruptRegister(SocketHandle s) = 0;
+
+        virtual std::uint8_t readInterruptRegister() = 0;
+        virtual void writeInterruptMaskRegister(std::uint8_t value) = 0;
+
+        virtual SocketStatus readSocketStatusRegister(SocketHandle s) = 0;
+        virtual SocketSnapshot readSocketState(SocketHandle s) = 0;
+
+        virtual std::uint16_t getTransmitFreeSize(SocketHandle s) = 0;
+        virtual std::uint16_t getReceiveFreeSize(SocketHandle s) = 0;
+
+        virtual void sendData(SocketHandle s, const std::span<const std::uint8_t> buffer) = 0;
+        virtual void sendData(SocketHandle s, std::span<const std::span<const std::uint8_t>> segments) = 0;
+        virtual std::uint16_t receiveData(SocketHandle s, std::span<std::uint8_t> buffer) = 0;
+
+        virtual std::uint16_t readTransmitPointer(SocketHandle s) = 0;
+        virtual void writeTransmitPointer(SocketHandle s, std::uint16_t value) = 0;
+        virtual std::uint16_t readReceivePointer(SocketHandle s) = 0;
+        virtual void writeReceivePointer(SocketHandle s, std::uint16_t value) = 0;
+
+        virtual void writeTransmitBuffer(SocketHandle s, std::uint16_t pointer, std::span<const std::uint8_t> buffer) = 0;
+        virtual void readReceiveBuffer(SocketHandle s, std::uint16_t pointer, std::span<std::uint8_t> buffer) = 0;
+
+        virtual void setDestAddress(SocketHandle s, NetAddress<4> addr, std::uint16_t port) = 0;
+
+        virtual std::uint16_t getTransmitBufferSize(SocketHandle s) const noexcept = 0;
+        virtual std::uint16_t getReceiveBufferSize(SocketHandle s) const noexcept = 0;
+        virtual std::uint16_t getReceiveBufferAddress(SocketHandle s) const noexcept = 0;
+    };
+
+}
@@ -26,4 +26,8 @@
 namespace platform
 {
     void wait(std::uint32_t milliseconds) noexcept;
+    std::uint32_t milliseconds() noexcept;
+
+    void enableCycleCounter() noexcept;
+    std::uint32_t cycles() noexcept;
 }
@@ -0,0 +1,57 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SocketHandle.h"
+#include <cstdint>
+#include <span>
+
+namespace eth
+{
+    class NetDevice;
+
+
+    class ReceiveQueue
+    {
+    public:
+        ReceiveQueue(SocketHandle socketHandle, NetDevice& dev, std::uint16_t minSize);
+
+
+        bool fetch();
+        void read(std::uint16_t offset, std::span<std::uint8_t> buffer);
+        void consume(std::uint16_t size);
+        void reset();
+
+        std::uint16_t available() const noexcept
+        {
+            return pending;
+        }
+
+
+    private:
+        SocketHandle handle;
+        NetDevice& device;
+        std::uint16_t headerSize;
+        std::uint16_t readPointer;
+        std::uint16_t pending;
+    };
+
+}
@@ -25,15 +25,14 @@
 #include "SocketInterrupt.h"
 #include "Protocol.h"
 #include "NetConfig.h"
+#include "async/Awaitable.h"
+#include <array>
 #include <cstdint>
 #include <span>
 
 namespace eth
 {
-    namespace w5100
-    {
-        class Device;
-    }
+    class NetDevice;
 
 
     class Socket
@@ -44,11 +43,31 @@ namespace eth
             ok,
             failed,
             closed,
-            timeout
+            timeout,
+            wouldBlock
         };
 
+        struct Result
+        {
+            Status status;
+            std::uint16_t size;
+        };
 
-        Socket(SocketHandle socketHandle, w5100::Device& dev);
+        struct ReceiveView
+        {
+            struct Segment
+            {
+                std::uint16_t address;
+                std::uint16_t size;
+            };
+
+            std::uint16_t pointer;
+            std::uint16_t size;
+            std::array<Segment, 2> segments;
+        };
+
+
+        Socket(SocketHandle socketHandle, NetDevice& dev);
         Socket(const Socket&) = delete;
         ~Socket();
 
@@ -58,12 +77,46 @@ namespace eth
         Status listen();
         void accept();
         std::uint16_t send(const std::span<const std::uint8_t> buffer);
+        std::uint16_t send(std::span<const std::span<const std::uint8_t>> segments);
         std::uint16_t receive(std::span<std::uint8_t> buffer);
 
 
         Status connect(NetAddress<4> address, std::uint16_t port);
         Status disconnect();
 
+        ReceiveView peek();
+        std::uint16_t read(const ReceiveView& view, std::uint16_t offset, std::span<std::uint8_t> buffer);
+        void consume(const ReceiveView& view, std::uint16_t size);
+
+        Status tryAccept();
+        Result trySend(const std::span<const std::uint8_t> buffer);
+        Result trySend(std::span<const std::span<const std::uint8_t>> segments);
+        Result tryReceive(std::span<std::uint8_t> buffer);
+        Status startConnect(NetAddress<4> address, std::uint16_t port);
+        Status pollConnect();
+        Status startDisconnect();
+        Status pollDisconnect();
+
+        auto asyncAccept(async::Scheduler& scheduler)
+        {
+            return async::Awaitable{scheduler, AcceptOperation{*this}};
+        }
+
+        auto asyncSend(async::Scheduler& scheduler, const std::span<const std::uint8_t> buffer)
+        {
+            return async::Awaitable{scheduler, SendOperation{*this, buffer}};
+        }
+
+        auto asyncReceive(async::Scheduler& scheduler, std::span<std::uint8_t> buffer)
+        {
+            return async::Awaitable{scheduler, ReceiveOperation{*this, buffer}};
+        }
+
+        auto asyncConnect(async::Scheduler& scheduler, NetAddress<4> address, std::uint16_t port)
+        {
+            return async::Awaitable{scheduler, ConnectOperation{*this, address, port, false}};
+        }
+
         SocketStatus getStatus() const;
 
 
@@ -71,12 +124,50 @@ namespace eth
 
 
     private:
+        struct AcceptOperation
+        {
+            Status operator()();
+            static bool isDone(Status status);
+
+            Socket& socket;
+        };
+
+        struct SendOperation
+        {
+            Result operator()();
+            static bool isDone(Result result);
+
+            Socket& socket;
+            std::span<const std::uint8_t> buffer;
+        };
+
+        struct ReceiveOperation
+        {
+            Result operator()();
+            static bool isDone(Result result);
+
+            Socket& socket;
+            std::span<std::uint8_t> buffer;
+        };
+
+        struct ConnectOperation
+        {
+            Status operator()();
+            static bool isDone(Status status);
+
+            Socket& socket;
+            NetAddress<4> address;
+            std::uint16_t port;
+            bool started;
+        };
+
+
         bool isTimeouted() const;
         void closeImpl();
 
 
         SocketHandle handle;
-        w5100::Device& device;
+        NetDevice& device;
     };
 
 }
@@ -26,6 +26,7 @@ namespace eth
 {
 
     inline constexpr std::uint8_t supportedSockets{4};
+    inline constexpr std::uint8_t maxSockets{8};
 
 
     class SocketHandle
@@ -51,10 +52,11 @@ namespace eth
     };
 
 
-    template <SocketHandle::value_type id>
+    template <SocketHandle::value_type id, std::uint8_t limit = supportedSockets>
     constexpr auto makeHandle() noexcept
     {
-        static_assert(id < supportedSockets, "Socket-Id out of range");
+        static_assert(limit <= maxSockets, "Socket limit out of range");
+        static_assert(id < limit, "Socket-Id out of range");
         return SocketHandle{id};
     }
 
@@ -0,0 +1,72 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SocketStatus.h"
+#include "SocketInterrupt.h"
+#include "Byte.h"
+#include <array>
+#include <cstdint>
+
+namespace eth
+{
+
+    struct SocketSnapshot
+    {
+        SocketStatus status;
+        SocketInterrupt interrupt;
+        std::uint16_t transmitFreeSize;
+        std::uint16_t transmitReadPointer;
+        std::uint16_t transmitWritePointer;
+        std::uint16_t receivedSize;
+        std::uint16_t receiveReadPointer;
+    };
+
+
+    namespace socketstate
+    {
+        inline constexpr std::uint16_t interruptOffset{0x02};
+        inline constexpr std::uint16_t statusOffset{0x03};
+        inline constexpr std::uint16_t pointerOffset{0x20};
+        inline constexpr std::size_t pointerSize{10};
+        inline constexpr std::size_t blockSize{0x2c};
+
+        using Block = std::array<std::uint8_t, blockSize>;
+
+
+        constexpr std::uint16_t wordAt(const Block& block, std::size_t offset) noexcept
+        {
+            return byte::to<std::uint16_t>(block[offset], block[offset + 1]);
+        }
+
+        constexpr SocketSnapshot decode(const Block& block) noexcept
+        {
+            return {static_cast<SocketStatus>(block[statusOffset]),
+                    SocketInterrupt{block[interruptOffset]},
+                    wordAt(block, 0x20),
+                    wordAt(block, 0x22),
+                    wordAt(block, 0x24),
+                    wordAt(block, 0x26),
+                    wordAt(block, 0x28)};
+        }
+    }
+
+}
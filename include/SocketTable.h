@@ -0,0 +1,97 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Socket.h"
+#include "SocketHandle.h"
+#include "SocketStatus.h"
+#include "SocketInterrupt.h"
+#include "Protocol.h"
+#include "NetConfig.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace eth
+{
+    class NetDevice;
+
+
+    class SocketTable
+    {
+    public:
+        explicit SocketTable(NetDevice& dev);
+        SocketTable(const SocketTable&) = delete;
+
+
+        std::optional<SocketHandle> allocate(Protocol protocol, std::uint16_t port, std::uint8_t flag = 0);
+        void release(SocketHandle s);
+        bool isAllocated(SocketHandle s) const noexcept;
+        std::uint8_t available() const noexcept;
+
+        void listen(SocketHandle s);
+        void connect(SocketHandle s, NetAddress<4> address, std::uint16_t port);
+        void disconnect(SocketHandle s);
+
+        Socket::Result trySend(SocketHandle s, std::span<const std::uint8_t> buffer);
+        Socket::Result tryReceive(SocketHandle s, std::span<std::uint8_t> buffer);
+
+        std::size_t poll();
+
+        Protocol protocol(SocketHandle s) const noexcept;
+        std::uint16_t localPort(SocketHandle s) const noexcept;
+        NetAddress<4> remoteAddress(SocketHandle s) const noexcept;
+        std::uint16_t remotePort(SocketHandle s) const noexcept;
+
+        SocketStatus status(SocketHandle s) const noexcept;
+        std::uint16_t transmitFreeSize(SocketHandle s) const noexcept;
+        std::uint16_t transmitWritePointer(SocketHandle s) const noexcept;
+        std::uint16_t receivedSize(SocketHandle s) const noexcept;
+        std::uint16_t receiveReadPointer(SocketHandle s) const noexcept;
+
+        SocketInterrupt pending(SocketHandle s) const noexcept;
+        void clearPending(SocketHandle s, SocketInterrupt::Mask mask) noexcept;
+
+
+        SocketTable& operator=(const SocketTable&) = delete;
+
+
+    private:
+        void resetEntry(SocketHandle s) noexcept;
+
+
+        NetDevice& device;
+        std::uint8_t freeMask;
+        std::array<Protocol, maxSockets> protocols;
+        std::array<std::uint16_t, maxSockets> localPorts;
+        std::array<NetAddress<4>, maxSockets> remoteAddresses;
+        std::array<std::uint16_t, maxSockets> remotePorts;
+        std::array<SocketStatus, maxSockets> statuses;
+        std::array<std::uint16_t, maxSockets> transmitFreeSizes;
+        std::array<std::uint16_t, maxSockets> transmitWritePointers;
+        std::array<std::uint16_t, maxSockets> receivedSizes;
+        std::array<std::uint16_t, maxSockets> receiveReadPointers;
+        std::array<std::uint8_t, maxSockets> pendingEvents;
+    };
+
+}
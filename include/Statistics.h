@@ -0,0 +1,125 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SocketHandle.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace eth::stats
+{
+
+#ifdef STM32_ETH_STATISTICS
+    inline constexpr bool enabled{true};
+#else
+    inline constexpr bool enabled{false};
+#endif
+
+
+    struct SocketCounters
+    {
+        std::uint32_t bytesSent;
+        std::uint32_t bytesReceived;
+        std::uint32_t sendCommands;
+        std::uint32_t receiveCommands;
+    };
+
+    struct Snapshot
+    {
+        std::array<SocketCounters, maxSockets> sockets;
+        std::uint32_t socketWaitIterations;
+        std::uint32_t commandWaitIterations;
+        std::uint32_t freeSizeRetries;
+        std::uint32_t spiFrames;
+    };
+
+
+    namespace detail
+    {
+        inline Snapshot counters{};
+    }
+
+
+    inline void countSend(SocketHandle s, std::size_t size) noexcept
+    {
+        if constexpr (enabled)
+        {
+            auto& socket = detail::counters.sockets[s.value()];
+            socket.bytesSent += size;
+            ++socket.sendCommands;
+        }
+    }
+
+    inline void countReceive(SocketHandle s, std::size_t size) noexcept
+    {
+        if constexpr (enabled)
+        {
+            auto& socket = detail::counters.sockets[s.value()];
+            socket.bytesReceived += size;
+            ++socket.receiveCommands;
+        }
+    }
+
+    inline void countSocketWait() noexcept
+    {
+        if constexpr (enabled)
+        {
+            ++detail::counters.socketWaitIterations;
+        }
+    }
+
+    inline void countCommandWait() noexcept
+    {
+        if constexpr (enabled)
+        {
+            ++detail::counters.commandWaitIterations;
+        }
+    }
+
+    inline void countFreeSizeRetry() noexcept
+    {
+        if constexpr (enabled)
+        {
+            ++detail::counters.freeSizeRetries;
+        }
+    }
+
+    inline void countSpiFrames([[maybe_unused]] std::size_t frames) noexcept
+    {
+        if constexpr (enabled)
+        {
+            detail::counters.spiFrames += frames;
+        }
+    }
+
+
+    inline Snapshot snapshot() noexcept
+    {
+        return detail::counters;
+    }
+
+    inline void reset() noexcept
+    {
+        detail::counters = {};
+    }
+
+}
@@ -0,0 +1,72 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Socket.h"
+#include "SocketHandle.h"
+#include <array>
+#include <cstdint>
+#include <optional>
+
+namespace eth
+{
+    class NetDevice;
+
+
+    class TcpServer
+    {
+    public:
+        TcpServer(NetDevice& dev, std::uint16_t listenPort, std::uint8_t backlog = supportedSockets);
+        TcpServer(const TcpServer&) = delete;
+
+
+        Socket::Status listen();
+        Socket* accept();
+        void release(Socket& socket);
+
+        std::uint8_t backlog() const noexcept
+        {
+            return count;
+        }
+
+        std::uint8_t connections() const noexcept;
+
+
+        TcpServer& operator=(const TcpServer&) = delete;
+
+
+    private:
+        struct Slot
+        {
+            std::optional<Socket> socket;
+            bool active;
+        };
+
+
+        Socket::Status rearm(Slot& slot);
+
+
+        std::uint16_t port;
+        std::uint8_t count;
+        std::array<Slot, maxSockets> slots;
+    };
+
+}
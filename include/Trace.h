@@ -0,0 +1,135 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Platform.h"
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace eth::trace
+{
+
+#ifdef STM32_ETH_TRACE
+    inline constexpr bool enabled{true};
+#else
+    inline constexpr bool enabled{false};
+#endif
+
+
+    enum class Probe : std::uint8_t
+    {
+        socketSend,
+        socketReceive,
+        executeCommand,
+        spiTransfer,
+        spiBlockTransfer
+    };
+
+    inline constexpr std::size_t probeCount{5};
+    inline constexpr std::size_t bucketCount{33};
+
+
+    struct Histogram
+    {
+        std::array<std::uint32_t, bucketCount> buckets;
+        std::uint32_t samples;
+        std::uint32_t max;
+        std::uint64_t total;
+    };
+
+
+    namespace detail
+    {
+        inline std::array<Histogram, probeCount> histograms{};
+    }
+
+
+    constexpr std::size_t bucketOf(std::uint32_t cycles) noexcept
+    {
+        return static_cast<std::size_t>(std::bit_width(cycles));
+    }
+
+    inline void record([[maybe_unused]] Probe probe, [[maybe_unused]] std::uint32_t cycles) noexcept
+    {
+        if constexpr (enabled)
+        {
+            auto& histogram = detail::histograms[static_cast<std::size_t>(probe)];
+            ++histogram.buckets[bucketOf(cycles)];
+            ++histogram.samples;
+            histogram.max = std::max(histogram.max, cycles);
+            histogram.total += cycles;
+        }
+    }
+
+    inline Histogram histogram(Probe probe) noexcept
+    {
+        return detail::histograms[static_cast<std::size_t>(probe)];
+    }
+
+    inline void reset() noexcept
+    {
+        detail::histograms = {};
+    }
+
+
+    class Scope
+    {
+    public:
+        explicit Scope(Probe p) noexcept
+            : probe(p), start(now())
+        {
+        }
+
+        Scope(const Scope&) = delete;
+
+        ~Scope()
+        {
+            if constexpr (enabled)
+            {
+                record(probe, now() - start);
+            }
+        }
+
+
+        Scope& operator=(const Scope&) = delete;
+
+
+    private:
+        static std::uint32_t now() noexcept
+        {
+            if constexpr (enabled)
+            {
+                return platform::cycles();
+            }
+            else
+            {
+                return 0;
+            }
+        }
+
+
+        Probe probe;
+        std::uint32_t start;
+    };
+
+}
@@ -0,0 +1,75 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Socket.h"
+#include "SocketHandle.h"
+#include "NetConfig.h"
+#include "ReceiveQueue.h"
+#include <cstdint>
+#include <span>
+
+namespace eth
+{
+    class NetDevice;
+
+
+    class UdpSocket
+    {
+    public:
+        using Status = Socket::Status;
+
+        struct Datagram
+        {
+            Status status;
+            NetAddress<4> address;
+            std::uint16_t port;
+            std::uint16_t size;
+        };
+
+
+        UdpSocket(SocketHandle socketHandle, NetDevice& dev);
+        UdpSocket(const UdpSocket&) = delete;
+        ~UdpSocket();
+
+
+        Status open(std::uint16_t port);
+        void close();
+
+        std::uint16_t sendTo(NetAddress<4> address, std::uint16_t port, std::span<const std::uint8_t> buffer);
+        Datagram receiveFrom(std::span<std::uint8_t> buffer);
+
+        SocketStatus getStatus() const;
+
+
+        UdpSocket& operator=(const UdpSocket&) = delete;
+
+
+    private:
+        void closeImpl();
+
+
+        SocketHandle handle;
+        NetDevice& device;
+        ReceiveQueue queue;
+    };
+
+}
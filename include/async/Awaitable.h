@@ -0,0 +1,73 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "async/Scheduler.h"
+#include <coroutine>
+#include <utility>
+
+namespace eth::async
+{
+
+    template <class Operation>
+    class Awaitable
+    {
+    public:
+        using result_type = decltype(std::declval<Operation&>()());
+
+
+        Awaitable(Scheduler& s, Operation op)
+            : scheduler(s), operation(op), result{}
+        {
+        }
+
+
+        bool await_ready()
+        {
+            return step(this);
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            return scheduler.wait(handle, &Awaitable::step, this);
+        }
+
+        result_type await_resume() const noexcept
+        {
+            return result;
+        }
+
+
+    private:
+        static bool step(void* awaiter)
+        {
+            auto& self = *static_cast<Awaitable*>(awaiter);
+            self.result = self.operation();
+            return Operation::isDone(self.result);
+        }
+
+
+        Scheduler& scheduler;
+        Operation operation;
+        result_type result;
+    };
+
+}
@@ -0,0 +1,65 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "async/Task.h"
+#include <array>
+#include <coroutine>
+#include <cstddef>
+
+namespace eth::async
+{
+
+    class Scheduler
+    {
+    public:
+        using PollFn = bool (*)(void* awaiter);
+
+        static inline constexpr std::size_t maxWaiters{8};
+
+        static_assert(maxWaiters >= maxFrames, "Every task frame requires a waiter slot");
+
+
+        Scheduler();
+        Scheduler(const Scheduler&) = delete;
+
+
+        bool wait(std::coroutine_handle<> handle, PollFn pollFn, void* awaiter);
+        std::size_t poll();
+        std::size_t pending() const noexcept;
+
+
+        Scheduler& operator=(const Scheduler&) = delete;
+
+
+    private:
+        struct Waiter
+        {
+            std::coroutine_handle<> handle;
+            PollFn poll;
+            void* awaiter;
+        };
+
+
+        std::array<Waiter, maxWaiters> waiters;
+    };
+
+}
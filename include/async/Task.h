@@ -0,0 +1,100 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SocketHandle.h"
+#include <coroutine>
+#include <cstddef>
+
+namespace eth::async
+{
+
+    inline constexpr std::size_t maxFrames{supportedSockets};
+    inline constexpr std::size_t frameSize{512};
+
+
+    void* allocateFrame(std::size_t size) noexcept;
+    void deallocateFrame(void* frame) noexcept;
+    std::size_t framesInUse() noexcept;
+
+
+    class Task
+    {
+    public:
+        struct promise_type
+        {
+            Task get_return_object() noexcept
+            {
+                return Task{true};
+            }
+
+            static Task get_return_object_on_allocation_failure() noexcept
+            {
+                return Task{false};
+            }
+
+            std::suspend_never initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void return_void() const noexcept
+            {
+            }
+
+            void unhandled_exception() const noexcept
+            {
+            }
+
+            static void* operator new(std::size_t size) noexcept
+            {
+                return allocateFrame(size);
+            }
+
+            static void operator delete(void* frame) noexcept
+            {
+                deallocateFrame(frame);
+            }
+        };
+
+
+        constexpr bool isStarted() const noexcept
+        {
+            return started;
+        }
+
+
+    private:
+        constexpr explicit Task(bool isStarted)
+            : started(isStarted)
+        {
+        }
+
+
+        bool started;
+    };
+
+}
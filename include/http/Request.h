@@ -0,0 +1,158 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace eth
+{
+    class Socket;
+}
+
+namespace eth::http
+{
+
+    enum class Method : std::uint8_t
+    {
+        get,
+        head,
+        post,
+        put,
+        del,
+        unknown
+    };
+
+
+    struct Request
+    {
+        std::uint16_t readBody(std::span<std::uint8_t> buffer);
+
+        std::uint32_t remainingBody() const noexcept
+        {
+            return contentLength - bodyRead;
+        }
+
+
+        Method method;
+        std::string_view path;
+        bool keepAlive;
+        std::uint32_t contentLength;
+        std::uint32_t bodyRead;
+        Socket* socket;
+    };
+
+
+    class RequestParser
+    {
+    public:
+        enum class Result : std::uint8_t
+        {
+            incomplete,
+            complete,
+            badRequest,
+            uriTooLong,
+            lengthRequired,
+            notImplemented
+        };
+
+        static inline constexpr std::size_t maxPathSize{64};
+
+
+        RequestParser();
+        RequestParser(const RequestParser&) = delete;
+
+
+        std::size_t parse(std::span<const std::uint8_t> data);
+        void reset() noexcept;
+
+        Result result() const noexcept
+        {
+            return parseResult;
+        }
+
+        Request request() const noexcept;
+
+
+        RequestParser& operator=(const RequestParser&) = delete;
+
+
+    private:
+        enum class State : std::uint8_t
+        {
+            method,
+            path,
+            version,
+            headerStart,
+            headerName,
+            headerValueStart,
+            headerValue,
+            done
+        };
+
+        template <std::size_t n>
+        struct Token
+        {
+            bool append(char c) noexcept
+            {
+                if (size == n)
+                {
+                    return false;
+                }
+
+                value[size++] = c;
+                return true;
+            }
+
+            std::string_view view() const noexcept
+            {
+                return {value.data(), size};
+            }
+
+            std::array<char, n> value;
+            std::size_t size;
+        };
+
+
+        void parse(char c);
+        void finishHeader();
+        void finishHeaders();
+        void fail(Result reason) noexcept;
+
+
+        State state;
+        Result parseResult;
+        Method method;
+        bool keepAlive;
+        std::uint32_t contentLength;
+        bool hasContentLength;
+        bool transferEncoded;
+        Token<8> token;
+        Token<maxPathSize> path;
+        Token<20> headerName;
+        Token<16> headerValue;
+        bool headerValueTruncated;
+    };
+
+}
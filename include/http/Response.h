@@ -0,0 +1,127 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Socket.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace eth::http
+{
+
+    enum class StatusCode : std::uint16_t
+    {
+        ok = 200,
+        noContent = 204,
+        badRequest = 400,
+        notFound = 404,
+        methodNotAllowed = 405,
+        lengthRequired = 411,
+        uriTooLong = 414,
+        internalServerError = 500,
+        notImplemented = 501
+    };
+
+
+    class OutputBuffer
+    {
+    public:
+        static inline constexpr std::size_t capacity{1024};
+
+
+        OutputBuffer();
+        OutputBuffer(const OutputBuffer&) = delete;
+
+
+        bool append(std::span<const std::span<const std::uint8_t>> segments, std::size_t skip);
+        Socket::Status flush(Socket& socket);
+
+        bool isEmpty() const noexcept
+        {
+            return head == tail;
+        }
+
+
+        OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+
+    private:
+        std::array<std::uint8_t, capacity> data;
+        std::size_t head;
+        std::size_t tail;
+    };
+
+
+    class Response
+    {
+    public:
+        static inline constexpr std::size_t maxChunkSize{512};
+
+
+        Response(Socket& s, OutputBuffer& buffer, bool keepAliveConnection, bool headersOnly = false);
+        Response(const Response&) = delete;
+
+
+        bool begin(StatusCode status, std::string_view contentType);
+        bool write(std::span<const std::uint8_t> data);
+        bool write(std::string_view text);
+        bool end();
+
+        bool send(StatusCode status, std::string_view contentType, std::string_view body);
+
+        bool isStarted() const noexcept
+        {
+            return started;
+        }
+
+        bool isFinished() const noexcept
+        {
+            return finished;
+        }
+
+        bool isFailed() const noexcept
+        {
+            return failed;
+        }
+
+
+        Response& operator=(const Response&) = delete;
+
+
+    private:
+        bool sendHeader(StatusCode status, std::string_view contentType, std::span<const std::uint8_t> length,
+                        std::span<const std::uint8_t> body);
+        bool transmit(std::span<const std::span<const std::uint8_t>> segments);
+
+
+        Socket& socket;
+        OutputBuffer& output;
+        bool keepAlive;
+        bool omitBody;
+        bool started;
+        bool finished;
+        bool failed;
+    };
+
+}
@@ -0,0 +1,160 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "http/Request.h"
+#include "http/Response.h"
+#include "Socket.h"
+#include "TcpServer.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace eth
+{
+    class NetDevice;
+}
+
+namespace eth::http
+{
+
+    using Handler = void (*)(Request& request, Response& response);
+
+
+    struct Route
+    {
+        Method method;
+        std::string_view path;
+        Handler handler;
+    };
+
+
+    constexpr const Route* findRoute(std::span<const Route> routes, std::string_view path, Method method)
+    {
+        for (const auto& route : routes)
+        {
+            if ((route.path == path) && (route.method == method))
+            {
+                return &route;
+            }
+        }
+
+        return nullptr;
+    }
+
+    constexpr bool hasPath(std::span<const Route> routes, std::string_view path)
+    {
+        for (const auto& route : routes)
+        {
+            if (route.path == path)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    constexpr bool hasUniqueRoutes(std::span<const Route> routes)
+    {
+        for (std::size_t i = 0; i < routes.size(); ++i)
+        {
+            if (findRoute(routes.first(i), routes[i].path, routes[i].method) != nullptr)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+
+    class Connection
+    {
+    public:
+        static inline constexpr std::size_t windowSize{32};
+
+
+        Connection(Socket& s, std::span<const Route> routeTable);
+        Connection(const Connection&) = delete;
+
+
+        Socket::Status poll();
+
+        Socket& socket() noexcept
+        {
+            return connection;
+        }
+
+
+        Connection& operator=(const Connection&) = delete;
+
+
+    private:
+        enum class State : std::uint8_t
+        {
+            open,
+            closing,
+            disconnecting
+        };
+
+
+        bool discardBody();
+        void dispatch();
+        void reject(StatusCode status);
+        Socket::Status idle(SocketStatus status);
+        Socket::Status drain();
+
+
+        Socket& connection;
+        std::span<const Route> routes;
+        RequestParser parser;
+        OutputBuffer output;
+        std::uint32_t pendingBody;
+        State state;
+    };
+
+
+    class Server
+    {
+    public:
+        Server(NetDevice& dev, std::uint16_t port, std::span<const Route> routeTable,
+               std::uint8_t backlog = supportedSockets);
+        Server(const Server&) = delete;
+
+
+        Socket::Status listen();
+        std::size_t poll();
+
+
+        Server& operator=(const Server&) = delete;
+
+
+    private:
+        TcpServer tcpServer;
+        std::span<const Route> routes;
+        std::array<std::optional<Connection>, maxSockets> connections;
+    };
+
+}
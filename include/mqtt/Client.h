@@ -0,0 +1,147 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "mqtt/Packet.h"
+#include "Socket.h"
+#include "NetConfig.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace eth::mqtt
+{
+
+#ifdef STM32_ETH_MQTT_PACKET_SIZE
+    inline constexpr std::size_t packetSize{STM32_ETH_MQTT_PACKET_SIZE};
+#else
+    inline constexpr std::size_t packetSize{128};
+#endif
+
+
+    struct Options
+    {
+        std::string_view clientId;
+        std::uint16_t keepAlive{60};
+        bool cleanSession{false};
+        std::uint16_t localPort{49152};
+        std::uint32_t responseTimeout{5000};
+    };
+
+
+    class Client
+    {
+    public:
+        static inline constexpr std::size_t maxInflight{8};
+        static inline constexpr std::size_t maxPacketSize{packetSize};
+
+        static_assert((maxPacketSize >= 16) && (maxPacketSize <= 0xffff), "MQTT packet size out of range");
+
+
+        Client(Socket& s, const Options& opts);
+        Client(const Client&) = delete;
+
+
+        Socket::Status connect(NetAddress<4> address, std::uint16_t port);
+        void disconnect();
+
+        // Fails if the encoded PUBLISH (header, topic and payload) exceeds maxPacketSize
+        Socket::Status publish(std::string_view topic, std::span<const std::uint8_t> payload, QoS qos);
+        Socket::Status flush();
+        Socket::Status poll();
+
+        bool isConnected() const noexcept
+        {
+            return state == State::connected;
+        }
+
+        bool isSessionPresent() const noexcept
+        {
+            return sessionPresent;
+        }
+
+        std::size_t pending() const noexcept
+        {
+            return tail - head;
+        }
+
+
+        Client& operator=(const Client&) = delete;
+
+
+    private:
+        enum class State : std::uint8_t
+        {
+            disconnected,
+            connecting,
+            connected
+        };
+
+        enum class SlotState : std::uint8_t
+        {
+            free,
+            queued,
+            awaitingAck
+        };
+
+        struct Slot
+        {
+            std::array<std::uint8_t, maxPacketSize> packet;
+            std::uint16_t size;
+            std::uint16_t packetId;
+            QoS qos;
+            SlotState state;
+        };
+
+
+        Slot& slotAt(std::size_t index) noexcept
+        {
+            return slots[index % maxInflight];
+        }
+
+        bool receive();
+        bool handle(const FixedHeader& header, std::span<const std::uint8_t> body);
+        void acknowledge(std::uint16_t packetId);
+        void resumeSession();
+        void releaseAcknowledged() noexcept;
+        bool sendPacket(std::span<const std::uint8_t> packet);
+        bool sendSegments(std::span<const std::span<const std::uint8_t>> segments);
+        Socket::Status keepConnectionAlive();
+        Socket::Status closeConnection(Socket::Status reason);
+
+
+        Socket& socket;
+        Options options;
+        State state;
+        bool sessionPresent;
+        bool pingPending;
+        std::uint16_t packetId;
+        std::uint32_t lastSent;
+        std::uint32_t requestSent;
+        std::size_t head;
+        std::size_t sent;
+        std::size_t tail;
+        std::array<Slot, maxInflight> slots;
+    };
+
+}
@@ -0,0 +1,79 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace eth::mqtt
+{
+
+    enum class PacketType : std::uint8_t
+    {
+        connect = 1,
+        connack = 2,
+        publish = 3,
+        puback = 4,
+        pingreq = 12,
+        pingresp = 13,
+        disconnect = 14
+    };
+
+    enum class QoS : std::uint8_t
+    {
+        atMostOnce = 0,
+        atLeastOnce = 1
+    };
+
+
+    struct ConnectOptions
+    {
+        std::string_view clientId;
+        std::uint16_t keepAlive;
+        bool cleanSession;
+    };
+
+    struct FixedHeader
+    {
+        PacketType type;
+        std::uint8_t flags;
+        std::uint32_t remainingLength;
+        std::size_t size;
+    };
+
+
+    inline constexpr std::uint8_t dupFlag{0x08};
+    inline constexpr std::size_t maxFixedHeaderSize{5};
+
+    inline constexpr std::array<std::uint8_t, 2> pingRequest{{0xc0, 0x00}};
+    inline constexpr std::array<std::uint8_t, 2> disconnectRequest{{0xe0, 0x00}};
+
+
+    std::size_t encodeConnect(std::span<std::uint8_t> buffer, const ConnectOptions& options);
+    std::size_t encodePublish(std::span<std::uint8_t> buffer, std::string_view topic, std::span<const std::uint8_t> payload,
+                              QoS qos, std::uint16_t packetId);
+
+    std::size_t decodeFixedHeader(std::span<const std::uint8_t> data, FixedHeader& header);
+
+}
@@ -0,0 +1,49 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "Byte.h"
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace eth::spi
+{
+
+    enum class OpCode : std::uint8_t
+    {
+        read = 0x0f,
+        write = 0xf0
+    };
+
+
+    inline constexpr std::size_t packetHeaderSize{3};
+    inline constexpr std::size_t packetSize{packetHeaderSize + sizeof(std::uint8_t)};
+
+
+    template <OpCode opcode, class... Ts>
+    constexpr auto makePacket(std::uint16_t address, Ts&&... params)
+    {
+        using Type = std::array<std::uint8_t, packetHeaderSize + sizeof...(Ts)>;
+        return Type{{static_cast<std::uint8_t>(opcode), byte::get<1>(address), byte::get<0>(address), std::forward<Ts>(params)...}};
+    }
+
+}
@@ -0,0 +1,140 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "spi/SpiWriter.h"
+#include "spi/Packet.h"
+#include "Statistics.h"
+#include "Trace.h"
+#include <cstdint>
+#include <span>
+
+namespace eth::spi
+{
+
+    template <class SpiRegisters, class GpioRegisters>
+    class BasicRegisterTransport
+    {
+    public:
+        BasicRegisterTransport(SpiRegisters& spiRegisters, GpioRegisters& gpioRegisters, std::uint16_t slaveSelectPin)
+            : spi(spiRegisters), gpio(gpioRegisters), pin(slaveSelectPin)
+        {
+            spi.CR1 = spi.CR1 | SPI_CR1_SPE;
+        }
+
+        BasicRegisterTransport(const BasicRegisterTransport&) = delete;
+
+
+        void write(std::uint16_t address, std::uint8_t data)
+        {
+            const trace::Scope scope{trace::Probe::spiTransfer};
+            stats::countSpiFrames(1);
+            transferFrame(makePacket<OpCode::write>(address, data));
+        }
+
+        std::uint8_t read(std::uint16_t address)
+        {
+            const trace::Scope scope{trace::Probe::spiTransfer};
+            stats::countSpiFrames(1);
+            return transferFrame(makePacket<OpCode::read>(address, std::uint8_t{0}));
+        }
+
+        void writeBlock(std::uint16_t address, std::span<const std::uint8_t> data)
+        {
+            const trace::Scope scope{trace::Probe::spiBlockTransfer};
+            stats::countSpiFrames(data.size());
+
+            for (const auto value : data)
+            {
+                transferFrame(makePacket<OpCode::write>(address++, value));
+            }
+        }
+
+        void readBlock(std::uint16_t address, std::span<std::uint8_t> data)
+        {
+            const trace::Scope scope{trace::Probe::spiBlockTransfer};
+            stats::countSpiFrames(data.size());
+
+            for (auto& value : data)
+            {
+                value = transferFrame(makePacket<OpCode::read>(address++, std::uint8_t{0}));
+            }
+        }
+
+
+        BasicRegisterTransport& operator=(const BasicRegisterTransport&) = delete;
+
+
+    private:
+        std::uint8_t transferFrame(const std::array<std::uint8_t, packetSize>& frame)
+        {
+            gpio.BSRR = std::uint32_t{pin} << 16;
+
+            std::uint8_t value{0};
+
+            for (const auto data : frame)
+            {
+                value = transfer(data);
+            }
+
+            while ((spi.SR & SPI_SR_BSY) != 0)
+            {
+                // Wait for completion
+            }
+
+            gpio.BSRR = std::uint32_t{pin};
+
+            return value;
+        }
+
+        std::uint8_t transfer(std::uint8_t data)
+        {
+            while ((spi.SR & SPI_SR_TXE) == 0)
+            {
+                // Wait for empty transmit buffer
+            }
+
+            spi.DR = data;
+
+            while ((spi.SR & SPI_SR_RXNE) == 0)
+            {
+                // Wait for received data
+            }
+
+            return static_cast<std::uint8_t>(spi.DR);
+        }
+
+
+        SpiRegisters& spi;
+        GpioRegisters& gpio;
+        std::uint16_t pin;
+    };
+
+
+    using RegisterTransport = BasicRegisterTransport<SPI_TypeDef, GPIO_TypeDef>;
+
+
+    inline RegisterTransport makeRegisterTransport(SpiWriter& writer)
+    {
+        return RegisterTransport{*writer.nativeHandle().Instance, writer.slaveSelectPort(), writer.slaveSelectPin()};
+    }
+
+}
@@ -51,4 +51,15 @@ namespace eth::spi
         {SPI_MODE_MASTER, SPI_DIRECTION_2LINES, SPI_DATASIZE_8BIT, SPI_POLARITY_LOW, SPI_PHASE_1EDGE, SPI_NSS_SOFT,
          SPI_BAUDRATEPRESCALER_4, SPI_FIRSTBIT_MSB, SPI_TIMODE_DISABLED, SPI_CRCCALCULATION_DISABLED, 0}};
 
+
+    enum class DmaController : std::uint8_t
+    {
+        dma1,
+        dma2
+    };
+
+    using DmaConfig = std::tuple<DmaController, std::uint8_t, std::uint8_t, std::uint32_t>;
+
+    inline constexpr DmaConfig spi2Dma{DmaController::dma1, 4, 3, DMA_CHANNEL_0};
+
 }
@@ -0,0 +1,102 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "spi/SpiConfig.h"
+#include "spi/Packet.h"
+#include <array>
+#include <span>
+#include <cstdint>
+
+namespace eth::spi
+{
+    class SpiWriter;
+
+
+    class SpiDma
+    {
+    public:
+        using Callback = void (*)(void* context, bool success);
+
+        template <class T>
+        struct Segment
+        {
+            std::uint16_t address;
+            std::span<T> data;
+        };
+
+        using WriteSegment = Segment<const std::uint8_t>;
+        using ReadSegment = Segment<std::uint8_t>;
+
+
+        SpiDma(SpiWriter& spiWriter, const DmaConfig& cfg);
+        SpiDma(const SpiDma&) = delete;
+
+
+        bool startWrite(std::span<const WriteSegment> segments, Callback callback, void* context);
+        bool startRead(std::span<const ReadSegment> segments, Callback callback, void* context);
+
+        bool isBusy() const noexcept;
+
+        void handleTransmitInterrupt();
+        void handleReceiveInterrupt();
+        void onComplete(SPI_HandleTypeDef* hspi);
+        void onError(SPI_HandleTypeDef* hspi);
+
+
+        SpiDma& operator=(const SpiDma&) = delete;
+
+
+        static inline constexpr std::size_t maxSegments{2};
+
+
+    private:
+        struct Transfer
+        {
+            std::uint16_t address;
+            const std::uint8_t* source;
+            std::uint8_t* destination;
+            std::size_t size;
+        };
+
+        template <class T>
+        bool start(std::span<const Segment<T>> segments, Callback callback, void* context);
+        void onFrameComplete();
+        void startFrame();
+        void finish(bool success);
+
+
+        SpiWriter& writer;
+        DMA_HandleTypeDef transmitDma{};
+        DMA_HandleTypeDef receiveDma{};
+        std::array<Transfer, maxSegments> transfers{};
+        std::size_t transferCount{0};
+        std::size_t transferIndex{0};
+        std::size_t position{0};
+        std::array<std::uint8_t, packetSize> transmitFrame{};
+        std::array<std::uint8_t, packetSize> receiveFrame{};
+        Callback completionCallback{nullptr};
+        void* completionContext{nullptr};
+        volatile bool busy{false};
+        bool reading{false};
+    };
+
+}
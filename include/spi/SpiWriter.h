@@ -21,6 +21,7 @@
 #pragma once
 
 #include "spi/SpiConfig.h"
+#include <span>
 
 namespace eth::spi
 {
@@ -38,13 +39,23 @@ namespace eth::spi
         void write(std::uint16_t address, std::uint8_t data);
         std::uint8_t read(std::uint16_t address);
 
+        void writeBlock(std::uint16_t address, std::span<const std::uint8_t> data);
+        void readBlock(std::uint16_t address, std::span<std::uint8_t> data);
+
+        void writeFrame(std::span<const std::uint8_t> header, std::span<const std::uint8_t> data);
+        void readFrame(std::span<const std::uint8_t> header, std::span<std::uint8_t> data);
+
         Handle& nativeHandle() noexcept;
+        GPIO_TypeDef& slaveSelectPort() const noexcept;
+        std::uint16_t slaveSelectPin() const noexcept;
 
 
         SpiWriter& operator=(const SpiWriter&) = delete;
 
 
     private:
+        friend class SpiDma;
+
         enum class PinState : std::uint8_t
         {
             set,
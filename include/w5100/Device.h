@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include "NetDevice.h"
 #include "SocketHandle.h"
 #include "SocketCommand.h"
 #include "SocketStatus.h"
@@ -27,46 +28,301 @@
 #include "Mode.h"
 #include "NetConfig.h"
 #include "w5100/Register.h"
+#include "w5100/Registers.h"
+#include "w5100/MemoryLayout.h"
+#include "w5100/ShadowRegister.h"
+#include "spi/SpiWriter.h"
+#include "spi/SpiDma.h"
 #include "Byte.h"
 #include "Concepts.h"
+#include "Statistics.h"
+#include "Trace.h"
 #include <algorithm>
 #include <iterator>
 #include <cstdint>
 #include <span>
 
-namespace eth::spi
-{
-    class SpiWriter;
-}
-
 namespace eth::w5100
 {
 
-    class Device
+    namespace detail
+    {
+        constexpr std::uint16_t toBufferMask(std::uint16_t bufferSize)
+        {
+            return bufferSize - 1;
+        }
+
+        constexpr bool isWrapAround(std::size_t offset, std::size_t size, std::size_t limit)
+        {
+            return (offset + size) > limit;
+        }
+    }
+
+
+    template <Transport SpiTransport>
+    class BasicDevice : public NetDevice
     {
     public:
-        explicit Device(spi::SpiWriter& writer);
-        Device(const Device&) = delete;
+        using TransferCallback = spi::SpiDma::Callback;
 
 
-        void executeSocketCommand(SocketHandle s, SocketCommand cmd);
+        explicit BasicDevice(SpiTransport& transport, MemoryLayout memoryLayout = defaultMemoryLayout)
+            : spiWriter(transport), layout(memoryLayout)
+        {
+            writeModeRegister(Mode::reset);
+            write(registers::transmitMemorySize, layout.transmitMemorySize());
+            write(registers::receiveMemorySize, layout.receiveMemorySize());
+        }
 
-        void writeSocketModeRegister(SocketHandle s, std::uint8_t value);
-        void writeSocketSourcePort(SocketHandle s, std::uint16_t value);
+        BasicDevice(const BasicDevice&) = delete;
 
-        void writeSocketInterruptRegister(SocketHandle s, SocketInterrupt value);
-        SocketInterrupt readSocketInterruptRegister(SocketHandle s);
 
-        void writeSocketCommandRegister(SocketHandle s, SocketCommand value);
-        SocketCommand readSocketCommandRegister(SocketHandle s);
+        std::uint8_t getSocketCount() const noexcept override
+        {
+            return supportedSockets;
+        }
 
-        SocketStatus readSocketStatusRegister(SocketHandle s);
+        void executeSocketCommand(SocketHandle s, SocketCommand cmd) override
+        {
+            const trace::Scope scope{trace::Probe::executeCommand};
 
-        std::uint16_t getTransmitFreeSize(SocketHandle s);
-        std::uint16_t getReceiveFreeSize(SocketHandle s);
+            if (cmd == SocketCommand::listen)
+            {
+                shadows[s.value()].destAddress.invalidate();
+                shadows[s.value()].destPort.invalidate();
+            }
+
+            if ((cmd == SocketCommand::open) || (cmd == SocketCommand::listen) || (cmd == SocketCommand::connect) ||
+                (cmd == SocketCommand::close))
+            {
+                shadows[s.value()].transmitPointer.invalidate();
+                shadows[s.value()].receivePointer.invalidate();
+            }
 
-        void sendData(SocketHandle s, const std::span<const std::uint8_t> buffer);
-        std::uint16_t receiveData(SocketHandle s, std::span<std::uint8_t> buffer);
+            writeSocketCommandRegister(s, cmd);
+
+            while (readSocketCommandRegister(s) != SocketCommand::executed)
+            {
+                stats::countCommandWait();
+            }
+        }
+
+        void writeSocketModeRegister(SocketHandle s, std::uint8_t value) override
+        {
+            writeShadowed(shadows[s.value()].mode, registers::socketMode(s), value);
+        }
+
+        std::uint8_t readSocketModeRegister(SocketHandle s)
+        {
+            return readShadowed(shadows[s.value()].mode, registers::socketMode(s));
+        }
+
+        void writeSocketSourcePort(SocketHandle s, std::uint16_t value) override
+        {
+            writeShadowed(shadows[s.value()].sourcePort, registers::socketSourcePort(s), value);
+        }
+
+        std::uint16_t readSocketSourcePort(SocketHandle s)
+        {
+            return readShadowed(shadows[s.value()].sourcePort, registers::socketSourcePort(s));
+        }
+
+        void writeSocketInterruptRegister(SocketHandle s, SocketInterrupt value) override
+        {
+            write(registers::socketInterrupt(s), value.value());
+        }
+
+        SocketInterrupt readSocketInterruptRegister(SocketHandle s) override
+        {
+            return static_cast<SocketInterrupt>(read(registers::socketInterrupt(s)));
+        }
+
+        std::uint8_t readInterruptRegister() override
+        {
+            return read(registers::interrupt);
+        }
+
+        void writeInterruptMaskRegister(std::uint8_t value) override
+        {
+            write(registers::interruptMask, value);
+        }
+
+        void writeSocketCommandRegister(SocketHandle s, SocketCommand value)
+        {
+            write(registers::socketCommand(s), static_cast<std::uint8_t>(value));
+        }
+
+        SocketCommand readSocketCommandRegister(SocketHandle s)
+        {
+            return static_cast<SocketCommand>(read(registers::socketCommand(s)));
+        }
+
+        SocketStatus readSocketStatusRegister(SocketHandle s) override
+        {
+            return static_cast<SocketStatus>(read(registers::socketStatus(s)));
+        }
+
+        SocketSnapshot readSocketState(SocketHandle s) override
+        {
+            using socketstate::Block;
+
+            Block block{};
+            const auto flags = std::next(block.begin(), socketstate::interruptOffset);
+            const auto pointers = std::next(block.begin(), socketstate::pointerOffset);
+            read(makeRegister<Block>(s, socketstate::interruptOffset), flags, std::next(flags, 2));
+            read(makeRegister<Block>(s, socketstate::pointerOffset), pointers, std::next(pointers, socketstate::pointerSize));
+
+            return socketstate::decode(block);
+        }
+
+        std::uint16_t getTransmitFreeSize(SocketHandle s) override
+        {
+            return readFreesize(registers::socketTransmitFreeSize(s));
+        }
+
+        std::uint16_t getReceiveFreeSize(SocketHandle s) override
+        {
+            return readFreesize(registers::socketReceiveFreeSize(s));
+        }
+
+        void sendData(SocketHandle s, const std::span<const std::uint8_t> buffer) override
+        {
+            const std::uint16_t writePointer = readTransmitPointer(s);
+            writeTransmitBuffer(s, writePointer, buffer);
+            writeTransmitPointer(s, static_cast<std::uint16_t>(writePointer + buffer.size()));
+        }
+
+        void sendData(SocketHandle s, std::span<const std::span<const std::uint8_t>> segments) override
+        {
+            const std::uint16_t writePointer = readTransmitPointer(s);
+            std::uint16_t pointer = writePointer;
+
+            for (const auto& segment : segments)
+            {
+                if (segment.empty() == false)
+                {
+                    writeTransmitBuffer(s, pointer, segment);
+                    pointer += segment.size();
+                }
+            }
+
+            writeTransmitPointer(s, pointer);
+        }
+
+        std::uint16_t receiveData(SocketHandle s, std::span<std::uint8_t> buffer) override
+        {
+            const std::uint16_t readPointer = readReceivePointer(s);
+            readReceiveBuffer(s, readPointer, buffer);
+            writeReceivePointer(s, static_cast<std::uint16_t>(readPointer + buffer.size()));
+
+            return buffer.size();
+        }
+
+        std::uint16_t readTransmitPointer(SocketHandle s) override
+        {
+            return readShadowed(shadows[s.value()].transmitPointer, registers::socketTransmitWritePointer(s));
+        }
+
+        void writeTransmitPointer(SocketHandle s, std::uint16_t value) override
+        {
+            writeShadowed(shadows[s.value()].transmitPointer, registers::socketTransmitWritePointer(s), value);
+        }
+
+        std::uint16_t readReceivePointer(SocketHandle s) override
+        {
+            return readShadowed(shadows[s.value()].receivePointer, registers::socketReceiveReadPointer(s));
+        }
+
+        void writeReceivePointer(SocketHandle s, std::uint16_t value) override
+        {
+            writeShadowed(shadows[s.value()].receivePointer, registers::socketReceiveReadPointer(s), value);
+        }
+
+        void writeTransmitBuffer(SocketHandle s, std::uint16_t pointer, std::span<const std::uint8_t> buffer) override
+        {
+            const auto size = buffer.size();
+            const auto bufferSize = layout.transmitBufferSize(s);
+            const auto baseAddress = layout.transmitBufferAddress(s);
+            const std::uint16_t offset = pointer & detail::toBufferMask(bufferSize);
+            const std::uint16_t destAddress = offset + baseAddress;
+
+            if (detail::isWrapAround(offset, size, bufferSize))
+            {
+                const auto first = bufferSize - offset;
+                const auto border = std::next(buffer.begin(), first);
+                write(makeRegister<std::span<const std::uint8_t>>(destAddress), buffer.begin(), border);
+                write(makeRegister<std::span<const std::uint8_t>>(baseAddress), border, buffer.end());
+            }
+            else
+            {
+                write(Register<std::span<const std::uint8_t>>(destAddress), buffer.begin(), buffer.end());
+            }
+        }
+
+        void readReceiveBuffer(SocketHandle s, std::uint16_t pointer, std::span<std::uint8_t> buffer) override
+        {
+            const auto size = buffer.size();
+            const auto bufferSize = layout.receiveBufferSize(s);
+            const auto baseAddress = layout.receiveBufferAddress(s);
+            const std::uint16_t offset = pointer & detail::toBufferMask(bufferSize);
+            const std::uint16_t destAddress = offset + baseAddress;
+            const auto reg = makeRegister<std::span<std::uint8_t>>(destAddress);
+
+            if (detail::isWrapAround(offset, size, bufferSize))
+            {
+                const auto first = bufferSize - offset;
+                auto border = std::next(buffer.begin(), first);
+
+                read(reg, buffer.begin(), border);
+                read(makeRegister<std::span<std::uint8_t>>(baseAddress), border, buffer.end());
+            }
+            else
+            {
+                read(reg, buffer.begin(), buffer.end());
+            }
+        }
+
+        bool sendDataAsync(SocketHandle s, std::span<const std::uint8_t> buffer, spi::SpiDma& dma, TransferCallback callback, void* context)
+        {
+            if (dma.isBusy())
+            {
+                return false;
+            }
+
+            const auto bufferSize = layout.transmitBufferSize(s);
+            const auto baseAddress = layout.transmitBufferAddress(s);
+            const std::uint16_t writePointer = readTransmitPointer(s);
+            const std::uint16_t offset = writePointer & detail::toBufferMask(bufferSize);
+            const auto first = std::min<std::size_t>(buffer.size(), bufferSize - offset);
+            const std::array<spi::SpiDma::WriteSegment, spi::SpiDma::maxSegments> segments{
+                {{static_cast<std::uint16_t>(baseAddress + offset), buffer.first(first)},
+                 {baseAddress, buffer.subspan(first)}}};
+
+            pendingTransfer = PendingTransfer{s, static_cast<std::uint16_t>(writePointer + buffer.size()), true, callback, context};
+
+            return dma.startWrite(segments, &BasicDevice::onTransferComplete, this);
+        }
+
+        bool receiveDataAsync(SocketHandle s, std::span<std::uint8_t> buffer, spi::SpiDma& dma, TransferCallback callback, void* context)
+        {
+            if (dma.isBusy())
+            {
+                return false;
+            }
+
+            const auto bufferSize = layout.receiveBufferSize(s);
+            const auto baseAddress = layout.receiveBufferAddress(s);
+            const std::uint16_t readPointer = readReceivePointer(s);
+            const std::uint16_t offset = readPointer & detail::toBufferMask(bufferSize);
+            const auto first = std::min<std::size_t>(buffer.size(), bufferSize - offset);
+            const std::array<spi::SpiDma::ReadSegment, spi::SpiDma::maxSegments> segments{
+                {{static_cast<std::uint16_t>(baseAddress + offset), buffer.first(first)},
+                 {baseAddress, buffer.subspan(first)}}};
+
+            pendingTransfer = PendingTransfer{s, static_cast<std::uint16_t>(readPointer + buffer.size()), false, callback, context};
+
+            return dma.startRead(segments, &BasicDevice::onTransferComplete, this);
+        }
 
         template <class T, std::size_t n = sizeof(T)>
             requires IntegralType<T>
@@ -88,9 +344,16 @@ namespace eth::w5100
             requires byte::ByteCompatibleIterator<Iterator>
         void write(Register<T> reg, Iterator begin, Iterator end)
         {
-            std::uint16_t offset = 0;
-            std::for_each(begin, end, [this, &reg, &offset](std::uint8_t data)
-                          { write(reg.address(), offset++, data); });
+            if constexpr (byte::ContiguousByteIterator<Iterator>)
+            {
+                spiWriter.writeBlock(reg.address(), std::span<const std::uint8_t>{begin, end});
+            }
+            else
+            {
+                std::uint16_t offset = 0;
+                std::for_each(begin, end, [this, &reg, &offset](std::uint8_t data)
+                              { write(reg.address(), offset++, data); });
+            }
         }
 
         template <class T, std::size_t n = sizeof(T)>
@@ -114,39 +377,222 @@ namespace eth::w5100
             requires byte::ByteCompatibleIterator<Iterator>
         auto read(Register<T> reg, Iterator begin, Iterator end)
         {
-            std::size_t offset = 0;
-            std::generate(begin, end, [this, &reg, &offset]
-                          { return read(reg.address(), offset++); });
+            if constexpr (byte::ContiguousByteIterator<Iterator>)
+            {
+                const std::span<std::uint8_t> buffer{begin, end};
+                spiWriter.readBlock(reg.address(), buffer);
+                return buffer.size();
+            }
+            else
+            {
+                std::size_t offset = 0;
+                std::generate(begin, end, [this, &reg, &offset]
+                              { return read(reg.address(), offset++); });
+
+                return offset;
+            }
+        }
+
+        void writeModeRegister(Mode value)
+        {
+            if (value == Mode::reset)
+            {
+                invalidateShadowRegisters();
+            }
+
+            write(registers::mode, static_cast<std::uint8_t>(value));
+        }
+
+        void setDestAddress(SocketHandle s, NetAddress<4> addr, std::uint16_t port) override
+        {
+            auto& shadow = shadows[s.value()];
+            writeShadowed(shadow.destAddress, registers::socketDestIpAddress(s), addr);
+            writeShadowed(shadow.destPort, registers::socketDestPort(s), port);
+        }
 
-            return offset;
+        void setNetConfig(const NetConfig& config)
+        {
+            const auto& [ip, subnet, gateway, mac] = config;
+            writeShadowed(netShadow.ip, registers::sourceIpAddress, ip);
+            writeShadowed(netShadow.subnet, registers::subnetMask, subnet);
+            writeShadowed(netShadow.gateway, registers::gatewayAddress, gateway);
+            writeShadowed(netShadow.mac, registers::sourceMacAddress, mac);
         }
 
-        void writeModeRegister(Mode value);
+        NetConfig readNetConfig()
+        {
+            return {readShadowed(netShadow.ip, registers::sourceIpAddress),
+                    readShadowed(netShadow.subnet, registers::subnetMask),
+                    readShadowed(netShadow.gateway, registers::gatewayAddress),
+                    readShadowed(netShadow.mac, registers::sourceMacAddress)};
+        }
 
-        void setDestAddress(SocketHandle s, NetAddress<4> addr, std::uint16_t port);
+        void invalidateShadowRegisters() noexcept
+        {
+            shadows = {};
+            netShadow = {};
+        }
 
 
-        static constexpr std::uint16_t getRxTxBufferSize() noexcept
+        std::uint16_t getTransmitBufferSize(SocketHandle s) const noexcept override
         {
-            return rxTxBufferSize;
-        };
+            return layout.transmitBufferSize(s);
+        }
 
+        std::uint16_t getReceiveBufferSize(SocketHandle s) const noexcept override
+        {
+            return layout.receiveBufferSize(s);
+        }
 
-        Device& operator=(const Device&) = delete;
+        std::uint16_t getReceiveBufferAddress(SocketHandle s) const noexcept override
+        {
+            return layout.receiveBufferAddress(s);
+        }
+
+
+        BasicDevice& operator=(const BasicDevice&) = delete;
 
 
     private:
-        void write(std::uint16_t addr, std::uint16_t offset, std::uint8_t data);
-        std::uint8_t read(std::uint16_t addr, std::uint16_t offset);
+        struct SocketShadow
+        {
+            ShadowRegister<std::uint8_t> mode;
+            ShadowRegister<std::uint16_t> sourcePort;
+            ShadowRegister<NetAddress<4>> destAddress;
+            ShadowRegister<std::uint16_t> destPort;
+            ShadowRegister<std::uint16_t> transmitPointer;
+            ShadowRegister<std::uint16_t> receivePointer;
+        };
+
+        struct PendingTransfer
+        {
+            SocketHandle socket;
+            std::uint16_t pointer;
+            bool transmit;
+            TransferCallback callback;
+            void* context;
+        };
+
+        struct NetShadow
+        {
+            ShadowRegister<NetAddress<4>> ip;
+            ShadowRegister<NetAddress<4>> subnet;
+            ShadowRegister<NetAddress<4>> gateway;
+            ShadowRegister<NetAddress<6>> mac;
+        };
+
+
+        template <class T>
+        void writeShadowed(ShadowRegister<T>& shadow, Register<T> reg, const T& value)
+        {
+            if (shadow.matches(value) == false)
+            {
+                if constexpr (IntegralType<T>)
+                {
+                    write(reg, value);
+                }
+                else
+                {
+                    write(reg, value.cbegin(), value.cend());
+                }
+                shadow.update(value);
+            }
+        }
+
+        template <class T>
+        T readShadowed(ShadowRegister<T>& shadow, Register<T> reg)
+        {
+            if (shadow.isValid() == false)
+            {
+                if constexpr (IntegralType<T>)
+                {
+                    shadow.update(read(reg));
+                }
+                else
+                {
+                    T value{};
+                    read(reg, value.begin(), value.end());
+                    shadow.update(value);
+                }
+            }
+            return shadow.value();
+        }
+
+        void write(std::uint16_t addr, std::uint16_t offset, std::uint8_t data)
+        {
+            spiWriter.write(addr + offset, data);
+        }
+
+        std::uint8_t read(std::uint16_t addr, std::uint16_t offset)
+        {
+            return spiWriter.read(addr + offset);
+        }
+
+        std::uint16_t readFreesize(Register<std::uint16_t> freesizeReg)
+        {
+            std::uint16_t firstRead{0};
+            std::uint16_t secondRead{0};
+
+            do
+            {
+                firstRead = read(freesizeReg);
+
+                if (firstRead != 0)
+                {
+                    secondRead = read(freesizeReg);
+                }
+
+                if (secondRead != firstRead)
+                {
+                    stats::countFreeSizeRetry();
+                }
+            } while (secondRead != firstRead);
+
+            return secondRead;
+        }
 
-        std::uint16_t readFreesize(Register<std::uint16_t> freesizeReg);
 
+        static void onTransferComplete(void* device, bool success)
+        {
+            auto& self = *static_cast<BasicDevice*>(device);
+            const auto transfer = self.pendingTransfer;
+
+            if (success)
+            {
+                if (transfer.transmit)
+                {
+                    self.writeTransmitPointer(transfer.socket, transfer.pointer);
+                }
+                else
+                {
+                    self.writeReceivePointer(transfer.socket, transfer.pointer);
+                }
+            }
 
-        spi::SpiWriter& spiWriter;
-        static inline constexpr std::uint16_t rxTxBufferSize{2048};
+            if (transfer.callback != nullptr)
+            {
+                transfer.callback(transfer.context, success);
+            }
+        }
+
+
+        SpiTransport& spiWriter;
+        const MemoryLayout layout;
+        std::array<SocketShadow, supportedSockets> shadows{};
+        NetShadow netShadow{};
+        PendingTransfer pendingTransfer{SocketHandle{0}, 0, false, nullptr, nullptr};
     };
 
 
-    void setupDevice(Device& dev, eth::NetConfig config);
+    template <Transport SpiTransport>
+    void setupDevice(BasicDevice<SpiTransport>& dev, eth::NetConfig config)
+    {
+        dev.setNetConfig(config);
+    }
+
+
+    extern template class BasicDevice<spi::SpiWriter>;
+
+    using Device = BasicDevice<spi::SpiWriter>;
 
 }
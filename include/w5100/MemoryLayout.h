@@ -0,0 +1,140 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SocketHandle.h"
+#include <array>
+#include <cstdint>
+
+namespace eth::w5100
+{
+
+    class MemoryLayout
+    {
+    public:
+        using Sizes = std::array<std::uint8_t, supportedSockets>;
+
+
+        consteval MemoryLayout(Sizes transmitSizes, Sizes receiveSizes)
+            : transmit(makePartition(transmitSizes)), receive(makePartition(receiveSizes))
+        {
+        }
+
+
+        constexpr std::uint8_t transmitMemorySize() const noexcept
+        {
+            return transmit.registerValue;
+        }
+
+        constexpr std::uint8_t receiveMemorySize() const noexcept
+        {
+            return receive.registerValue;
+        }
+
+        constexpr std::uint16_t transmitBufferSize(SocketHandle s) const noexcept
+        {
+            return transmit.sizes[s.value()];
+        }
+
+        constexpr std::uint16_t receiveBufferSize(SocketHandle s) const noexcept
+        {
+            return receive.sizes[s.value()];
+        }
+
+        constexpr std::uint16_t transmitBufferAddress(SocketHandle s) const noexcept
+        {
+            return transmitBaseAddress + transmit.offsets[s.value()];
+        }
+
+        constexpr std::uint16_t receiveBufferAddress(SocketHandle s) const noexcept
+        {
+            return receiveBaseAddress + receive.offsets[s.value()];
+        }
+
+
+    private:
+        struct Partition
+        {
+            std::array<std::uint16_t, supportedSockets> sizes;
+            std::array<std::uint16_t, supportedSockets> offsets;
+            std::uint8_t registerValue;
+        };
+
+
+        static void invalidMemoryLayout()
+        {
+        }
+
+        static constexpr std::uint8_t toRegisterValue(std::uint8_t sizeKb)
+        {
+            switch (sizeKb)
+            {
+                case 0:
+                case 1:
+                    return 0b00;
+                case 2:
+                    return 0b01;
+                case 4:
+                    return 0b10;
+                case 8:
+                    return 0b11;
+                default:
+                    invalidMemoryLayout();
+                    return 0b00;
+            }
+        }
+
+        static constexpr Partition makePartition(Sizes sizesKb)
+        {
+            Partition partition{};
+            std::uint16_t offset{0};
+
+            for (std::size_t i = 0; i < sizesKb.size(); ++i)
+            {
+                const std::uint16_t size = sizesKb[i] * 1024u;
+
+                if ((size == 0) != (offset == memorySize) || (offset + size) > memorySize)
+                {
+                    invalidMemoryLayout();
+                }
+
+                partition.sizes[i] = size;
+                partition.offsets[i] = offset;
+                partition.registerValue |= static_cast<std::uint8_t>(toRegisterValue(sizesKb[i]) << (i * 2));
+                offset += size;
+            }
+
+            return partition;
+        }
+
+
+        static inline constexpr std::uint16_t memorySize{8192};
+        static inline constexpr std::uint16_t transmitBaseAddress{0x4000};
+        static inline constexpr std::uint16_t receiveBaseAddress{0x6000};
+
+        Partition transmit;
+        Partition receive;
+    };
+
+
+    inline constexpr MemoryLayout defaultMemoryLayout{{{2, 2, 2, 2}}, {{2, 2, 2, 2}}};
+
+}
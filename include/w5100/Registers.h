@@ -29,6 +29,8 @@ namespace eth::w5100::registers
     inline constexpr auto mode = makeRegister<std::uint8_t>(0x0000);
     inline constexpr auto transmitMemorySize = makeRegister<std::uint8_t>(0x001b);
     inline constexpr auto receiveMemorySize = makeRegister<std::uint8_t>(0x001a);
+    inline constexpr auto interrupt = makeRegister<std::uint8_t>(0x0015);
+    inline constexpr auto interruptMask = makeRegister<std::uint8_t>(0x0016);
 
     inline constexpr auto gatewayAddress = makeRegister<std::array<std::uint8_t, 4>>(0x0001);
     inline constexpr auto subnetMask = makeRegister<std::array<std::uint8_t, 4>>(0x0005);
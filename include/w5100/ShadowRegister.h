@@ -0,0 +1,62 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+namespace eth::w5100
+{
+
+    template <class T>
+    class ShadowRegister
+    {
+    public:
+        constexpr bool matches(const T& value) const noexcept
+        {
+            return valid && (cached == value);
+        }
+
+        constexpr bool isValid() const noexcept
+        {
+            return valid;
+        }
+
+        constexpr const T& value() const noexcept
+        {
+            return cached;
+        }
+
+        constexpr void update(const T& value) noexcept
+        {
+            cached = value;
+            valid = true;
+        }
+
+        constexpr void invalidate() noexcept
+        {
+            valid = false;
+        }
+
+
+    private:
+        T cached{};
+        bool valid{false};
+    };
+
+}
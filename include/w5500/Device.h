@@ -0,0 +1,222 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "NetDevice.h"
+#include "SocketHandle.h"
+#include "SocketCommand.h"
+#include "SocketStatus.h"
+#include "SocketInterrupt.h"
+#include "Mode.h"
+#include "NetConfig.h"
+#include "w5500/Register.h"
+#include "Byte.h"
+#include "Concepts.h"
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace eth::spi
+{
+    class SpiWriter;
+}
+
+namespace eth::w5500
+{
+
+    class BufferSizes
+    {
+    public:
+        using Sizes = std::array<std::uint8_t, supportedSockets>;
+
+
+        consteval BufferSizes(Sizes sizesKb)
+            : sizes(validate(sizesKb))
+        {
+        }
+
+
+        constexpr std::uint8_t operator[](std::size_t index) const noexcept
+        {
+            return sizes[index];
+        }
+
+
+    private:
+        static void invalidBufferSizes()
+        {
+        }
+
+        static constexpr bool isValidSize(std::uint8_t sizeKb)
+        {
+            return (sizeKb <= 16) && ((sizeKb & (sizeKb - 1)) == 0);
+        }
+
+        static constexpr Sizes validate(Sizes sizesKb)
+        {
+            std::size_t total{0};
+
+            for (const auto size : sizesKb)
+            {
+                if (isValidSize(size) == false)
+                {
+                    invalidBufferSizes();
+                }
+
+                total += size;
+            }
+
+            if (total > memorySizeKb)
+            {
+                invalidBufferSizes();
+            }
+
+            return sizesKb;
+        }
+
+
+        static inline constexpr std::size_t memorySizeKb{16};
+
+        Sizes sizes;
+    };
+
+
+    inline constexpr BufferSizes defaultBufferSizes{{{2, 2, 2, 2, 2, 2, 2, 2}}};
+    inline constexpr std::uint16_t bufferBlockAddress{0x0000};
+
+
+    class Device : public NetDevice
+    {
+    public:
+        explicit Device(spi::SpiWriter& writer, BufferSizes transmitSizes = defaultBufferSizes, BufferSizes receiveSizes = defaultBufferSizes);
+        Device(const Device&) = delete;
+
+
+        std::uint8_t getSocketCount() const noexcept override
+        {
+            return supportedSockets;
+        }
+
+        void executeSocketCommand(SocketHandle s, SocketCommand cmd) override;
+
+        void writeSocketModeRegister(SocketHandle s, std::uint8_t value) override;
+        void writeSocketSourcePort(SocketHandle s, std::uint16_t value) override;
+
+        void writeSocketInterruptRegister(SocketHandle s, SocketInterrupt value) override;
+        SocketInterrupt readSocketInterruptRegister(SocketHandle s) override;
+
+        std::uint8_t readInterruptRegister() override;
+        void writeInterruptMaskRegister(std::uint8_t value) override;
+
+        SocketStatus readSocketStatusRegister(SocketHandle s) override;
+        SocketSnapshot readSocketState(SocketHandle s) override;
+
+        std::uint16_t getTransmitFreeSize(SocketHandle s) override;
+        std::uint16_t getReceiveFreeSize(SocketHandle s) override;
+
+        void sendData(SocketHandle s, const std::span<const std::uint8_t> buffer) override;
+        void sendData(SocketHandle s, std::span<const std::span<const std::uint8_t>> segments) override;
+        std::uint16_t receiveData(SocketHandle s, std::span<std::uint8_t> buffer) override;
+
+        std::uint16_t readTransmitPointer(SocketHandle s) override;
+        void writeTransmitPointer(SocketHandle s, std::uint16_t value) override;
+        std::uint16_t readReceivePointer(SocketHandle s) override;
+        void writeReceivePointer(SocketHandle s, std::uint16_t value) override;
+
+        void writeTransmitBuffer(SocketHandle s, std::uint16_t pointer, std::span<const std::uint8_t> buffer) override;
+        void readReceiveBuffer(SocketHandle s, std::uint16_t pointer, std::span<std::uint8_t> buffer) override;
+
+        template <class T>
+            requires IntegralType<T>
+        void write(Register<T> reg, T data)
+        {
+            std::array<std::uint8_t, sizeof(T)> bytes{};
+
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                bytes[i] = static_cast<std::uint8_t>(data >> ((sizeof(T) - 1 - i) * 8));
+            }
+
+            writeFrame(reg.block(), reg.address(), bytes);
+        }
+
+        template <class T>
+        void write(Register<T> reg, std::span<const std::uint8_t> data)
+        {
+            writeFrame(reg.block(), reg.address(), data);
+        }
+
+        template <class T>
+            requires IntegralType<T>
+        T read(Register<T> reg)
+        {
+            std::array<std::uint8_t, sizeof(T)> bytes{};
+            readFrame(reg.block(), reg.address(), bytes);
+
+            T value{0};
+
+            for (const auto b : bytes)
+            {
+                value = static_cast<T>((value << 8) | b);
+            }
+            return value;
+        }
+
+        void writeModeRegister(Mode value);
+
+        void setDestAddress(SocketHandle s, NetAddress<4> addr, std::uint16_t port) override;
+
+
+        std::uint16_t getTransmitBufferSize(SocketHandle s) const noexcept override
+        {
+            return transmitBufferSizes[s.value()] * 1024;
+        }
+
+        std::uint16_t getReceiveBufferSize(SocketHandle s) const noexcept override
+        {
+            return receiveBufferSizes[s.value()] * 1024;
+        }
+
+        std::uint16_t getReceiveBufferAddress([[maybe_unused]] SocketHandle s) const noexcept override
+        {
+            return bufferBlockAddress;
+        }
+
+
+        Device& operator=(const Device&) = delete;
+
+
+    private:
+        void writeFrame(std::uint8_t block, std::uint16_t address, std::span<const std::uint8_t> data);
+        void readFrame(std::uint8_t block, std::uint16_t address, std::span<std::uint8_t> data);
+
+        std::uint16_t readFreesize(Register<std::uint16_t> freesizeReg);
+
+
+        spi::SpiWriter& spiWriter;
+        const BufferSizes transmitBufferSizes;
+        const BufferSizes receiveBufferSizes;
+    };
+
+
+    void setupDevice(Device& dev, eth::NetConfig config);
+
+}
@@ -0,0 +1,102 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SocketHandle.h"
+#include <cstdint>
+
+namespace eth::w5500
+{
+
+    inline constexpr std::uint8_t supportedSockets{8};
+
+
+    template <SocketHandle::value_type id>
+    constexpr auto makeHandle() noexcept
+    {
+        return eth::makeHandle<id, supportedSockets>();
+    }
+
+
+    namespace block
+    {
+        inline constexpr std::uint8_t common{0x00};
+
+        constexpr std::uint8_t socketRegister(SocketHandle s) noexcept
+        {
+            return (s.value() * 4) + 1;
+        }
+
+        constexpr std::uint8_t transmitBuffer(SocketHandle s) noexcept
+        {
+            return (s.value() * 4) + 2;
+        }
+
+        constexpr std::uint8_t receiveBuffer(SocketHandle s) noexcept
+        {
+            return (s.value() * 4) + 3;
+        }
+    }
+
+
+    template <class T>
+    class Register
+    {
+    public:
+        using value_type = T;
+
+
+        constexpr Register(std::uint8_t block, std::uint16_t address) noexcept
+            : regBlock(block), regAddress(address)
+        {
+        }
+
+
+        constexpr std::uint8_t block() const noexcept
+        {
+            return regBlock;
+        }
+
+        constexpr std::uint16_t address() const noexcept
+        {
+            return regAddress;
+        }
+
+
+    private:
+        std::uint8_t regBlock;
+        std::uint16_t regAddress;
+    };
+
+
+    template <class T>
+    constexpr auto makeRegister(std::uint16_t address) noexcept
+    {
+        return Register<T>{block::common, address};
+    }
+
+    template <class T>
+    constexpr auto makeRegister(SocketHandle s, std::uint16_t address) noexcept
+    {
+        return Register<T>{block::socketRegister(s), address};
+    }
+
+}
@@ -0,0 +1,143 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "InterruptDispatcher.h"
+#include "NetDevice.h"
+
+namespace eth
+{
+    namespace
+    {
+        constexpr std::array<InterruptDispatcher::Event, 5> events{{InterruptDispatcher::Event::connect,
+                                                                    InterruptDispatcher::Event::disconnect,
+                                                                    InterruptDispatcher::Event::receive,
+                                                                    InterruptDispatcher::Event::timeout,
+                                                                    InterruptDispatcher::Event::send}};
+
+        constexpr bool isSocketInterrupt(std::uint8_t value, SocketHandle s)
+        {
+            return (value & (1u << s.value())) != 0;
+        }
+    }
+
+
+    InterruptDispatcher::InterruptDispatcher(NetDevice& dev)
+        : device(dev), entries{}, pending(false)
+    {
+    }
+
+    void InterruptDispatcher::registerHandler(SocketHandle s, Handler handler, void* context)
+    {
+        entries[s.value()] = Entry{handler, context};
+        updateInterruptMask();
+    }
+
+    void InterruptDispatcher::unregisterHandler(SocketHandle s)
+    {
+        entries[s.value()] = Entry{nullptr, nullptr};
+        updateInterruptMask();
+    }
+
+    void InterruptDispatcher::notify()
+    {
+        pending = true;
+    }
+
+    bool InterruptDispatcher::isPending() const
+    {
+        return pending;
+    }
+
+    std::size_t InterruptDispatcher::process()
+    {
+        if (pending == false)
+        {
+            return 0;
+        }
+
+        pending = false;
+        std::size_t dispatched{0};
+        std::uint8_t status{0};
+
+        const std::uint8_t socketCount = device.getSocketCount();
+        const auto handlerMask = interruptMask();
+
+        while (((status = device.readInterruptRegister()) & handlerMask) != 0)
+        {
+            for (std::uint8_t i = 0; i < socketCount; ++i)
+            {
+                const SocketHandle s{i};
+
+                if (isSocketInterrupt(status & handlerMask, s))
+                {
+                    const auto value = device.readSocketInterruptRegister(s);
+                    device.writeSocketInterruptRegister(s, value);
+                    dispatched += dispatch(s, value);
+                }
+            }
+        }
+
+        return dispatched;
+    }
+
+    std::size_t InterruptDispatcher::dispatch(SocketHandle s, SocketInterrupt value) const
+    {
+        const auto [handler, context] = entries[s.value()];
+
+        if (handler == nullptr)
+        {
+            return 0;
+        }
+
+        std::size_t dispatched{0};
+
+        for (const auto event : events)
+        {
+            if (value.test(event))
+            {
+                handler(s, event, context);
+                ++dispatched;
+            }
+        }
+
+        return dispatched;
+    }
+
+    void InterruptDispatcher::updateInterruptMask()
+    {
+        device.writeInterruptMaskRegister(interruptMask());
+    }
+
+    std::uint8_t InterruptDispatcher::interruptMask() const
+    {
+        std::uint8_t mask{0};
+
+        for (std::uint8_t i = 0; i < device.getSocketCount(); ++i)
+        {
+            if (entries[i].handler != nullptr)
+            {
+                mask |= static_cast<std::uint8_t>(1u << i);
+            }
+        }
+
+        return mask;
+    }
+
+}
@@ -0,0 +1,175 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MacRawSocket.h"
+#include "NetDevice.h"
+#include "SocketCommand.h"
+#include "Protocol.h"
+#include "Byte.h"
+#include <algorithm>
+#include <array>
+
+namespace eth
+{
+    namespace
+    {
+        inline constexpr std::uint16_t headerSize{2};
+
+
+        constexpr std::uint16_t toFrameLength(std::span<const std::uint8_t, headerSize> header)
+        {
+            return byte::to<std::uint16_t>(header[0], header[1]);
+        }
+    }
+
+
+    MacRawSocket::MacRawSocket(NetDevice& dev)
+        : handle(makeHandle<0>()), device(dev), queue(handle, dev, headerSize)
+    {
+    }
+
+    MacRawSocket::~MacRawSocket()
+    {
+        closeImpl();
+    }
+
+    MacRawSocket::Status MacRawSocket::open(std::uint8_t flag)
+    {
+        close();
+        device.writeSocketModeRegister(handle, static_cast<std::uint8_t>(Protocol::macRaw) | flag);
+        device.executeSocketCommand(handle, SocketCommand::open);
+
+        return (getStatus() == SocketStatus::macRaw ? Status::ok : Status::failed);
+    }
+
+    void MacRawSocket::close()
+    {
+        closeImpl();
+
+        while (getStatus() != SocketStatus::closed)
+        {
+            // Wait for completion
+        }
+    }
+
+    std::uint16_t MacRawSocket::sendFrame(std::span<const std::uint8_t> frame)
+    {
+        if (frame.empty() || (frame.size() > device.getTransmitBufferSize(handle)))
+        {
+            return 0;
+        }
+
+        const std::uint16_t size = frame.size();
+
+        while (device.getTransmitFreeSize(handle) < size)
+        {
+            if (getStatus() != SocketStatus::macRaw)
+            {
+                return 0;
+            }
+        }
+
+        device.sendData(handle, frame);
+        device.executeSocketCommand(handle, SocketCommand::send);
+
+        while (device.readSocketInterruptRegister(handle).test(SocketInterrupt::Mask::send) == false)
+        {
+            // Wait for completion
+        }
+
+        device.writeSocketInterruptRegister(handle, SocketInterrupt{SocketInterrupt::Mask::send});
+
+        return size;
+    }
+
+    MacRawSocket::Result MacRawSocket::receiveFrame(std::span<std::uint8_t> buffer)
+    {
+        if (queue.fetch() == false)
+        {
+            return {Status::wouldBlock, 0};
+        }
+
+        std::array<std::uint8_t, headerSize> header{};
+        queue.read(0, header);
+
+        const std::uint16_t frameLength = std::clamp<std::uint16_t>(toFrameLength(header), headerSize, queue.available());
+        const std::uint16_t size = std::min<std::uint16_t>(frameLength - headerSize, buffer.size());
+
+        if (size > 0)
+        {
+            queue.read(headerSize, buffer.first(size));
+        }
+
+        queue.consume(frameLength);
+
+        return {Status::ok, size};
+    }
+
+    std::size_t MacRawSocket::receiveFrames(std::span<std::uint8_t> buffer, std::span<std::span<std::uint8_t>> frames)
+    {
+        if (frames.empty() || (buffer.size() < headerSize) || (queue.fetch() == false))
+        {
+            return 0;
+        }
+
+        const std::uint16_t size = std::min<std::size_t>(queue.available(), buffer.size());
+        const auto data = buffer.first(size);
+        queue.read(0, data);
+
+        std::size_t count{0};
+        std::uint16_t offset{0};
+
+        while (((offset + headerSize) <= size) && (count < frames.size()))
+        {
+            const auto frameLength = toFrameLength(data.subspan(offset).first<headerSize>());
+
+            if ((frameLength < headerSize) || ((offset + frameLength) > size))
+            {
+                break;
+            }
+
+            frames[count++] = data.subspan(offset + headerSize, frameLength - headerSize);
+            offset += frameLength;
+        }
+
+        if (count == 0)
+        {
+            const auto frameLength = toFrameLength(data.first<headerSize>());
+            offset = (frameLength < headerSize ? queue.available() : frameLength);
+        }
+
+        queue.consume(offset);
+
+        return count;
+    }
+
+    SocketStatus MacRawSocket::getStatus() const
+    {
+        return device.readSocketStatusRegister(handle);
+    }
+
+    void MacRawSocket::closeImpl()
+    {
+        queue.reset();
+        device.executeSocketCommand(handle, SocketCommand::close);
+        device.writeSocketInterruptRegister(handle, SocketInterrupt{0xff});
+    }
+
+}
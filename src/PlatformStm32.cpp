@@ -27,4 +27,21 @@ namespace platform
         HAL_Delay(milliseconds);
     }
 
+    std::uint32_t milliseconds() noexcept
+    {
+        return HAL_GetTick();
+    }
+
+    void enableCycleCounter() noexcept
+    {
+        CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    std::uint32_t cycles() noexcept
+    {
+        return DWT->CYCCNT;
+    }
+
 }
@@ -0,0 +1,76 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ReceiveQueue.h"
+#include "SocketCommand.h"
+#include "NetDevice.h"
+#include <algorithm>
+
+namespace eth
+{
+
+    ReceiveQueue::ReceiveQueue(SocketHandle socketHandle, NetDevice& dev, std::uint16_t minSize)
+        : handle(socketHandle), device(dev), headerSize(minSize), readPointer(0), pending(0)
+    {
+    }
+
+    bool ReceiveQueue::fetch()
+    {
+        if (pending == 0)
+        {
+            const auto size = device.getReceiveFreeSize(handle);
+
+            if (size < headerSize)
+            {
+                return false;
+            }
+
+            pending = size;
+            readPointer = device.readReceivePointer(handle);
+        }
+
+        return true;
+    }
+
+    void ReceiveQueue::read(std::uint16_t offset, std::span<std::uint8_t> buffer)
+    {
+        device.readReceiveBuffer(handle, readPointer + offset, buffer);
+    }
+
+    void ReceiveQueue::consume(std::uint16_t size)
+    {
+        const auto consumed = std::min(size, pending);
+        readPointer += consumed;
+        pending -= consumed;
+
+        if (pending < headerSize)
+        {
+            pending = 0;
+            device.writeReceivePointer(handle, readPointer);
+            device.executeSocketCommand(handle, SocketCommand::receive);
+        }
+    }
+
+    void ReceiveQueue::reset()
+    {
+        pending = 0;
+    }
+
+}
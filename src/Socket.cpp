@@ -19,10 +19,12 @@
  */
 
 #include "Socket.h"
-#include "w5100/Device.h"
+#include "NetDevice.h"
 #include "SocketStatus.h"
 #include "SocketCommand.h"
 #include "Platform.h"
+#include "Statistics.h"
+#include "Trace.h"
 #include <algorithm>
 
 namespace eth
@@ -46,6 +48,8 @@ namespace eth
                 {
                     return actual;
                 }
+
+                stats::countSocketWait();
             }
 
             return 0;
@@ -54,7 +58,7 @@ namespace eth
     }
 
 
-    Socket::Socket(SocketHandle socketHandle, w5100::Device& dev)
+    Socket::Socket(SocketHandle socketHandle, NetDevice& dev)
         : handle(socketHandle), device(dev)
     {
     }
@@ -117,12 +121,14 @@ namespace eth
 
     std::uint16_t Socket::send(const std::span<const std::uint8_t> buffer)
     {
+        const trace::Scope scope{trace::Probe::socketSend};
+
         if (buffer.empty())
         {
             return 0;
         }
 
-        const std::uint16_t sendSize = std::min<std::uint16_t>(w5100::Device::getRxTxBufferSize(), buffer.size());
+        const std::uint16_t sendSize = std::min<std::uint16_t>(device.getTransmitBufferSize(handle), buffer.size());
         const auto freeSize = waitFor([this]
                                       { return device.getTransmitFreeSize(handle); },
                                       [this]
@@ -134,14 +140,51 @@ namespace eth
             return 0;
         }
 
-        device.sendData(handle, buffer);
+        device.sendData(handle, buffer.first(sendSize));
         device.executeSocketCommand(handle, SocketCommand::send);
+        stats::countSend(handle, sendSize);
+
+        return sendSize;
+    }
+
+    std::uint16_t Socket::send(std::span<const std::span<const std::uint8_t>> segments)
+    {
+        const trace::Scope scope{trace::Probe::socketSend};
+        std::size_t totalSize{0};
+
+        for (const auto& segment : segments)
+        {
+            totalSize += segment.size();
+        }
+
+        if ((totalSize == 0) || (totalSize > device.getTransmitBufferSize(handle)))
+        {
+            return 0;
+        }
+
+        const std::uint16_t sendSize = totalSize;
+        const auto freeSize = waitFor([this]
+                                      { return device.getTransmitFreeSize(handle); },
+                                      [this]
+                                      { return connectionReady(getStatus()); },
+                                      sendSize);
+
+        if (freeSize == 0)
+        {
+            return 0;
+        }
+
+        device.sendData(handle, segments);
+        device.executeSocketCommand(handle, SocketCommand::send);
+        stats::countSend(handle, sendSize);
 
         return sendSize;
     }
 
     std::uint16_t Socket::receive(std::span<std::uint8_t> buffer)
     {
+        const trace::Scope scope{trace::Probe::socketReceive};
+
         if (buffer.empty())
         {
             return 0;
@@ -160,11 +203,12 @@ namespace eth
             return 0;
         }
 
-        const std::uint16_t sizeLimited = std::min<std::uint16_t>(w5100::Device::getRxTxBufferSize(), buffer.size());
+        const std::uint16_t sizeLimited = std::min<std::uint16_t>(device.getReceiveBufferSize(handle), buffer.size());
         const std::uint16_t receiveSize = std::min(available, sizeLimited);
         auto shrinkedBuffer = buffer.first(receiveSize);
         device.receiveData(handle, shrinkedBuffer);
         device.executeSocketCommand(handle, SocketCommand::receive);
+        stats::countReceive(handle, receiveSize);
 
         return receiveSize;
     }
@@ -205,6 +249,267 @@ namespace eth
         return Status::ok;
     }
 
+    Socket::ReceiveView Socket::peek()
+    {
+        const std::uint16_t available = device.getReceiveFreeSize(handle);
+
+        if (available == 0)
+        {
+            return {};
+        }
+
+        const std::uint16_t pointer = device.readReceivePointer(handle);
+        const std::uint16_t bufferSize = device.getReceiveBufferSize(handle);
+        const std::uint16_t baseAddress = device.getReceiveBufferAddress(handle);
+        const std::uint16_t offset = pointer & (bufferSize - 1);
+        const std::uint16_t first = std::min<std::uint16_t>(available, bufferSize - offset);
+
+        return {pointer,
+                available,
+                {{{static_cast<std::uint16_t>(baseAddress + offset), first},
+                  {baseAddress, static_cast<std::uint16_t>(available - first)}}}};
+    }
+
+    std::uint16_t Socket::read(const ReceiveView& view, std::uint16_t offset, std::span<std::uint8_t> buffer)
+    {
+        if (offset >= view.size)
+        {
+            return 0;
+        }
+
+        const std::uint16_t size = std::min<std::uint16_t>(view.size - offset, buffer.size());
+        device.readReceiveBuffer(handle, view.pointer + offset, buffer.first(size));
+
+        return size;
+    }
+
+    void Socket::consume(const ReceiveView& view, std::uint16_t size)
+    {
+        const std::uint16_t consumed = std::min(size, view.size);
+
+        if (consumed == 0)
+        {
+            return;
+        }
+
+        device.writeReceivePointer(handle, view.pointer + consumed);
+        device.executeSocketCommand(handle, SocketCommand::receive);
+        stats::countReceive(handle, consumed);
+    }
+
+    Socket::Status Socket::tryAccept()
+    {
+        const auto status = getStatus();
+
+        if ((status == SocketStatus::listen) || (status == SocketStatus::synRecv))
+        {
+            return Status::wouldBlock;
+        }
+
+        return connectionReady(status) ? Status::ok : Status::closed;
+    }
+
+    Socket::Result Socket::trySend(const std::span<const std::uint8_t> buffer)
+    {
+        if (buffer.empty())
+        {
+            return {Status::ok, 0};
+        }
+
+        if (connectionReady(getStatus()) == false)
+        {
+            return {Status::closed, 0};
+        }
+
+        const std::uint16_t sizeLimited = std::min<std::uint16_t>(device.getTransmitBufferSize(handle), buffer.size());
+        const std::uint16_t sendSize = std::min(device.getTransmitFreeSize(handle), sizeLimited);
+
+        if (sendSize == 0)
+        {
+            return {Status::wouldBlock, 0};
+        }
+
+        device.sendData(handle, buffer.first(sendSize));
+        device.executeSocketCommand(handle, SocketCommand::send);
+        stats::countSend(handle, sendSize);
+
+        return {Status::ok, sendSize};
+    }
+
+    Socket::Result Socket::trySend(std::span<const std::span<const std::uint8_t>> segments)
+    {
+        std::size_t totalSize{0};
+
+        for (const auto& segment : segments)
+        {
+            totalSize += segment.size();
+        }
+
+        if (totalSize == 0)
+        {
+            return {Status::ok, 0};
+        }
+
+        if (connectionReady(getStatus()) == false)
+        {
+            return {Status::closed, 0};
+        }
+
+        const std::uint16_t freeSize = device.getTransmitFreeSize(handle);
+
+        if (freeSize == 0)
+        {
+            return {Status::wouldBlock, 0};
+        }
+
+        std::uint16_t sendSize = freeSize;
+
+        if (totalSize <= freeSize)
+        {
+            sendSize = static_cast<std::uint16_t>(totalSize);
+            device.sendData(handle, segments);
+        }
+        else
+        {
+            std::uint16_t remaining = freeSize;
+
+            for (auto it = segments.begin(); remaining > 0; ++it)
+            {
+                const auto part = it->first(std::min<std::size_t>(it->size(), remaining));
+
+                if (part.empty() == false)
+                {
+                    device.sendData(handle, part);
+                }
+
+                remaining = static_cast<std::uint16_t>(remaining - part.size());
+            }
+        }
+
+        device.executeSocketCommand(handle, SocketCommand::send);
+        stats::countSend(handle, sendSize);
+
+        return {Status::ok, sendSize};
+    }
+
+    Socket::Result Socket::tryReceive(std::span<std::uint8_t> buffer)
+    {
+        if (buffer.empty())
+        {
+            return {Status::ok, 0};
+        }
+
+        const auto status = getStatus();
+
+        if (connectionReady(status) == false)
+        {
+            return {Status::closed, 0};
+        }
+
+        const std::uint16_t available = device.getReceiveFreeSize(handle);
+
+        if (available == 0)
+        {
+            return {(status == SocketStatus::closeWait ? Status::closed : Status::wouldBlock), 0};
+        }
+
+        const std::uint16_t sizeLimited = std::min<std::uint16_t>(device.getReceiveBufferSize(handle), buffer.size());
+        const std::uint16_t receiveSize = std::min(available, sizeLimited);
+        device.receiveData(handle, buffer.first(receiveSize));
+        device.executeSocketCommand(handle, SocketCommand::receive);
+        stats::countReceive(handle, receiveSize);
+
+        return {Status::ok, receiveSize};
+    }
+
+    Socket::Status Socket::startConnect(NetAddress<4> address, std::uint16_t port)
+    {
+        device.setDestAddress(handle, address, port);
+        device.executeSocketCommand(handle, SocketCommand::connect);
+
+        return Status::wouldBlock;
+    }
+
+    Socket::Status Socket::pollConnect()
+    {
+        const auto status = getStatus();
+
+        if (status == SocketStatus::established)
+        {
+            return Status::ok;
+        }
+
+        if (status == SocketStatus::closed)
+        {
+            return Status::closed;
+        }
+
+        return isTimeouted() ? Status::timeout : Status::wouldBlock;
+    }
+
+    Socket::Status Socket::startDisconnect()
+    {
+        device.executeSocketCommand(handle, SocketCommand::disconnect);
+
+        return Status::wouldBlock;
+    }
+
+    Socket::Status Socket::pollDisconnect()
+    {
+        if (getStatus() == SocketStatus::closed)
+        {
+            return Status::ok;
+        }
+
+        return isTimeouted() ? Status::timeout : Status::wouldBlock;
+    }
+
+    Socket::Status Socket::AcceptOperation::operator()()
+    {
+        return socket.tryAccept();
+    }
+
+    bool Socket::AcceptOperation::isDone(Status status)
+    {
+        return status != Status::wouldBlock;
+    }
+
+    Socket::Result Socket::SendOperation::operator()()
+    {
+        return socket.trySend(buffer);
+    }
+
+    bool Socket::SendOperation::isDone(Result result)
+    {
+        return result.status != Status::wouldBlock;
+    }
+
+    Socket::Result Socket::ReceiveOperation::operator()()
+    {
+        return socket.tryReceive(buffer);
+    }
+
+    bool Socket::ReceiveOperation::isDone(Result result)
+    {
+        return result.status != Status::wouldBlock;
+    }
+
+    Socket::Status Socket::ConnectOperation::operator()()
+    {
+        if (started == false)
+        {
+            started = true;
+            socket.startConnect(address, port);
+        }
+
+        return socket.pollConnect();
+    }
+
+    bool Socket::ConnectOperation::isDone(Status status)
+    {
+        return status != Status::wouldBlock;
+    }
+
     SocketStatus Socket::getStatus() const
     {
         return device.readSocketStatusRegister(handle);
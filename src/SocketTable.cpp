@@ -0,0 +1,323 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SocketTable.h"
+#include "SocketCommand.h"
+#include "NetDevice.h"
+#include "Statistics.h"
+#include <algorithm>
+#include <bit>
+
+namespace eth
+{
+    namespace
+    {
+        constexpr std::uint8_t toBit(SocketHandle s)
+        {
+            return static_cast<std::uint8_t>(1u << s.value());
+        }
+
+        constexpr SocketStatus statusAfterOpen(Protocol protocol)
+        {
+            switch (protocol)
+            {
+                case Protocol::tcp:
+                    return SocketStatus::init;
+                case Protocol::udp:
+                    return SocketStatus::udp;
+                case Protocol::macRaw:
+                    return SocketStatus::macRaw;
+                default:
+                    return SocketStatus::closed;
+            }
+        }
+
+        constexpr bool connectionReady(SocketStatus status)
+        {
+            return (status == SocketStatus::established) || (status == SocketStatus::closeWait);
+        }
+    }
+
+
+    SocketTable::SocketTable(NetDevice& dev)
+        : device(dev), freeMask(static_cast<std::uint8_t>((1u << dev.getSocketCount()) - 1u)), protocols{},
+          localPorts{}, remoteAddresses{}, remotePorts{}, statuses{}, transmitFreeSizes{}, transmitWritePointers{},
+          receivedSizes{}, receiveReadPointers{}, pendingEvents{}
+    {
+    }
+
+    std::optional<SocketHandle> SocketTable::allocate(Protocol protocol, std::uint16_t port, std::uint8_t flag)
+    {
+        if (freeMask == 0)
+        {
+            return std::nullopt;
+        }
+
+        const SocketHandle s{static_cast<SocketHandle::value_type>(std::countr_zero(freeMask))};
+        freeMask = static_cast<std::uint8_t>(freeMask & ~toBit(s));
+
+        resetEntry(s);
+        protocols[s.value()] = protocol;
+        localPorts[s.value()] = port;
+
+        device.writeSocketModeRegister(s, static_cast<std::uint8_t>(protocol) | flag);
+        device.writeSocketSourcePort(s, port);
+        device.executeSocketCommand(s, SocketCommand::open);
+
+        const auto status = device.readSocketStatusRegister(s);
+
+        if ((status == SocketStatus::closed) || (status != statusAfterOpen(protocol)))
+        {
+            release(s);
+            return std::nullopt;
+        }
+
+        statuses[s.value()] = status;
+        return s;
+    }
+
+    void SocketTable::release(SocketHandle s)
+    {
+        if (isAllocated(s) == false)
+        {
+            return;
+        }
+
+        device.executeSocketCommand(s, SocketCommand::close);
+        device.writeSocketInterruptRegister(s, SocketInterrupt{0xff});
+
+        resetEntry(s);
+        freeMask = static_cast<std::uint8_t>(freeMask | toBit(s));
+    }
+
+    bool SocketTable::isAllocated(SocketHandle s) const noexcept
+    {
+        return (s.value() < device.getSocketCount()) && ((freeMask & toBit(s)) == 0);
+    }
+
+    std::uint8_t SocketTable::available() const noexcept
+    {
+        return static_cast<std::uint8_t>(std::popcount(freeMask));
+    }
+
+    void SocketTable::listen(SocketHandle s)
+    {
+        if (isAllocated(s) == false)
+        {
+            return;
+        }
+
+        device.executeSocketCommand(s, SocketCommand::listen);
+    }
+
+    void SocketTable::connect(SocketHandle s, NetAddress<4> address, std::uint16_t port)
+    {
+        if (isAllocated(s) == false)
+        {
+            return;
+        }
+
+        remoteAddresses[s.value()] = address;
+        remotePorts[s.value()] = port;
+
+        device.setDestAddress(s, address, port);
+        device.executeSocketCommand(s, SocketCommand::connect);
+    }
+
+    void SocketTable::disconnect(SocketHandle s)
+    {
+        if (isAllocated(s) == false)
+        {
+            return;
+        }
+
+        device.executeSocketCommand(s, SocketCommand::disconnect);
+    }
+
+    Socket::Result SocketTable::trySend(SocketHandle s, std::span<const std::uint8_t> buffer)
+    {
+        if (isAllocated(s) == false)
+        {
+            return {Socket::Status::failed, 0};
+        }
+
+        if (buffer.empty())
+        {
+            return {Socket::Status::ok, 0};
+        }
+
+        if (connectionReady(device.readSocketStatusRegister(s)) == false)
+        {
+            return {Socket::Status::closed, 0};
+        }
+
+        const std::uint16_t sizeLimited = std::min<std::uint16_t>(device.getTransmitBufferSize(s), buffer.size());
+        const std::uint16_t sendSize = std::min(device.getTransmitFreeSize(s), sizeLimited);
+
+        if (sendSize == 0)
+        {
+            return {Socket::Status::wouldBlock, 0};
+        }
+
+        device.sendData(s, buffer.first(sendSize));
+        device.executeSocketCommand(s, SocketCommand::send);
+        stats::countSend(s, sendSize);
+
+        return {Socket::Status::ok, sendSize};
+    }
+
+    Socket::Result SocketTable::tryReceive(SocketHandle s, std::span<std::uint8_t> buffer)
+    {
+        if (isAllocated(s) == false)
+        {
+            return {Socket::Status::failed, 0};
+        }
+
+        if (buffer.empty())
+        {
+            return {Socket::Status::ok, 0};
+        }
+
+        const auto status = device.readSocketStatusRegister(s);
+
+        if (connectionReady(status) == false)
+        {
+            return {Socket::Status::closed, 0};
+        }
+
+        const std::uint16_t available = device.getReceiveFreeSize(s);
+
+        if (available == 0)
+        {
+            return {(status == SocketStatus::closeWait ? Socket::Status::closed : Socket::Status::wouldBlock), 0};
+        }
+
+        const std::uint16_t sizeLimited = std::min<std::uint16_t>(device.getReceiveBufferSize(s), buffer.size());
+        const std::uint16_t receiveSize = std::min(available, sizeLimited);
+        device.receiveData(s, buffer.first(receiveSize));
+        device.executeSocketCommand(s, SocketCommand::receive);
+        stats::countReceive(s, receiveSize);
+
+        return {Socket::Status::ok, receiveSize};
+    }
+
+    std::size_t SocketTable::poll()
+    {
+        const auto allocatedMask = static_cast<std::uint8_t>(((1u << device.getSocketCount()) - 1u) & ~freeMask);
+        std::size_t pendingSockets{0};
+
+        for (auto mask = allocatedMask; mask != 0; mask = static_cast<std::uint8_t>(mask & (mask - 1u)))
+        {
+            const SocketHandle s{static_cast<SocketHandle::value_type>(std::countr_zero(mask))};
+            const auto i = s.value();
+            const auto state = device.readSocketState(s);
+
+            if (state.interrupt.value() != 0)
+            {
+                device.writeSocketInterruptRegister(s, state.interrupt);
+                pendingEvents[i] = static_cast<std::uint8_t>(pendingEvents[i] | state.interrupt.value());
+            }
+
+            statuses[i] = state.status;
+            transmitFreeSizes[i] = state.transmitFreeSize;
+            transmitWritePointers[i] = state.transmitWritePointer;
+            receivedSizes[i] = state.receivedSize;
+            receiveReadPointers[i] = state.receiveReadPointer;
+
+            if (pendingEvents[i] != 0)
+            {
+                ++pendingSockets;
+            }
+        }
+
+        return pendingSockets;
+    }
+
+    Protocol SocketTable::protocol(SocketHandle s) const noexcept
+    {
+        return protocols[s.value()];
+    }
+
+    std::uint16_t SocketTable::localPort(SocketHandle s) const noexcept
+    {
+        return localPorts[s.value()];
+    }
+
+    NetAddress<4> SocketTable::remoteAddress(SocketHandle s) const noexcept
+    {
+        return remoteAddresses[s.value()];
+    }
+
+    std::uint16_t SocketTable::remotePort(SocketHandle s) const noexcept
+    {
+        return remotePorts[s.value()];
+    }
+
+    SocketStatus SocketTable::status(SocketHandle s) const noexcept
+    {
+        return statuses[s.value()];
+    }
+
+    std::uint16_t SocketTable::transmitFreeSize(SocketHandle s) const noexcept
+    {
+        return transmitFreeSizes[s.value()];
+    }
+
+    std::uint16_t SocketTable::transmitWritePointer(SocketHandle s) const noexcept
+    {
+        return transmitWritePointers[s.value()];
+    }
+
+    std::uint16_t SocketTable::receivedSize(SocketHandle s) const noexcept
+    {
+        return receivedSizes[s.value()];
+    }
+
+    std::uint16_t SocketTable::receiveReadPointer(SocketHandle s) const noexcept
+    {
+        return receiveReadPointers[s.value()];
+    }
+
+    SocketInterrupt SocketTable::pending(SocketHandle s) const noexcept
+    {
+        return SocketInterrupt{pendingEvents[s.value()]};
+    }
+
+    void SocketTable::clearPending(SocketHandle s, SocketInterrupt::Mask mask) noexcept
+    {
+        pendingEvents[s.value()] = static_cast<std::uint8_t>(pendingEvents[s.value()] & ~static_cast<std::uint8_t>(mask));
+    }
+
+    void SocketTable::resetEntry(SocketHandle s) noexcept
+    {
+        const auto i = s.value();
+        protocols[i] = Protocol{};
+        localPorts[i] = 0;
+        remoteAddresses[i] = NetAddress<4>{};
+        remotePorts[i] = 0;
+        statuses[i] = SocketStatus::closed;
+        transmitFreeSizes[i] = 0;
+        transmitWritePointers[i] = 0;
+        receivedSizes[i] = 0;
+        receiveReadPointers[i] = 0;
+        pendingEvents[i] = 0;
+    }
+
+}
@@ -0,0 +1,119 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TcpServer.h"
+#include "NetDevice.h"
+#include <algorithm>
+#include <iterator>
+
+namespace eth
+{
+
+    TcpServer::TcpServer(NetDevice& dev, std::uint16_t listenPort, std::uint8_t backlog)
+        : port(listenPort), count(std::min(backlog, dev.getSocketCount())), slots{}
+    {
+        for (std::uint8_t i = 0; i < count; ++i)
+        {
+            slots[i].socket.emplace(SocketHandle{i}, dev);
+        }
+    }
+
+    Socket::Status TcpServer::listen()
+    {
+        auto result = Socket::Status::ok;
+
+        for (std::uint8_t i = 0; i < count; ++i)
+        {
+            if (rearm(slots[i]) != Socket::Status::ok)
+            {
+                result = Socket::Status::failed;
+            }
+        }
+
+        return result;
+    }
+
+    Socket* TcpServer::accept()
+    {
+        for (std::uint8_t i = 0; i < count; ++i)
+        {
+            auto& slot = slots[i];
+
+            if (slot.active == true)
+            {
+                continue;
+            }
+
+            switch (slot.socket->tryAccept())
+            {
+                case Socket::Status::ok:
+                    slot.active = true;
+                    return &(*slot.socket);
+                case Socket::Status::closed:
+                    rearm(slot);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        return nullptr;
+    }
+
+    void TcpServer::release(Socket& socket)
+    {
+        for (std::uint8_t i = 0; i < count; ++i)
+        {
+            auto& slot = slots[i];
+
+            if (&(*slot.socket) == &socket)
+            {
+                const auto status = socket.getStatus();
+
+                if ((status == SocketStatus::established) || (status == SocketStatus::closeWait))
+                {
+                    socket.disconnect();
+                }
+
+                rearm(slot);
+                return;
+            }
+        }
+    }
+
+    std::uint8_t TcpServer::connections() const noexcept
+    {
+        return static_cast<std::uint8_t>(std::count_if(slots.cbegin(), std::next(slots.cbegin(), count),
+                                                       [](const auto& slot) { return slot.active; }));
+    }
+
+    Socket::Status TcpServer::rearm(Slot& slot)
+    {
+        slot.active = false;
+
+        if (slot.socket->open(Protocol::tcp, port, 0) != Socket::Status::ok)
+        {
+            return Socket::Status::failed;
+        }
+
+        return slot.socket->listen();
+    }
+
+}
@@ -0,0 +1,145 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UdpSocket.h"
+#include "NetDevice.h"
+#include "SocketCommand.h"
+#include "Protocol.h"
+#include "Byte.h"
+#include <algorithm>
+#include <array>
+
+namespace eth
+{
+    namespace
+    {
+        inline constexpr std::uint16_t headerSize{8};
+        inline constexpr std::uint8_t sendCompletedMask{static_cast<std::uint8_t>(SocketInterrupt::Mask::send) |
+                                                         static_cast<std::uint8_t>(SocketInterrupt::Mask::timeout)};
+
+
+        constexpr bool isSendCompleted(SocketInterrupt value)
+        {
+            return (value.value() & sendCompletedMask) != 0;
+        }
+    }
+
+
+    UdpSocket::UdpSocket(SocketHandle socketHandle, NetDevice& dev)
+        : handle(socketHandle), device(dev), queue(socketHandle, dev, headerSize)
+    {
+    }
+
+    UdpSocket::~UdpSocket()
+    {
+        closeImpl();
+    }
+
+    UdpSocket::Status UdpSocket::open(std::uint16_t port)
+    {
+        close();
+        device.writeSocketModeRegister(handle, static_cast<std::uint8_t>(Protocol::udp));
+        device.writeSocketSourcePort(handle, port);
+        device.executeSocketCommand(handle, SocketCommand::open);
+
+        return (getStatus() == SocketStatus::udp ? Status::ok : Status::failed);
+    }
+
+    void UdpSocket::close()
+    {
+        closeImpl();
+
+        while (getStatus() != SocketStatus::closed)
+        {
+            // Wait for completion
+        }
+    }
+
+    std::uint16_t UdpSocket::sendTo(NetAddress<4> address, std::uint16_t port, std::span<const std::uint8_t> buffer)
+    {
+        if (buffer.empty() || (buffer.size() > device.getTransmitBufferSize(handle)))
+        {
+            return 0;
+        }
+
+        const std::uint16_t size = buffer.size();
+
+        while (device.getTransmitFreeSize(handle) < size)
+        {
+            if (getStatus() != SocketStatus::udp)
+            {
+                return 0;
+            }
+        }
+
+        device.setDestAddress(handle, address, port);
+        device.sendData(handle, buffer);
+        device.executeSocketCommand(handle, SocketCommand::send);
+
+        SocketInterrupt value{0};
+
+        do
+        {
+            value = device.readSocketInterruptRegister(handle);
+        } while (isSendCompleted(value) == false);
+
+        device.writeSocketInterruptRegister(handle, SocketInterrupt{sendCompletedMask});
+
+        return (value.test(SocketInterrupt::Mask::timeout) ? 0 : size);
+    }
+
+    UdpSocket::Datagram UdpSocket::receiveFrom(std::span<std::uint8_t> buffer)
+    {
+        if (queue.fetch() == false)
+        {
+            return {Status::wouldBlock, {}, 0, 0};
+        }
+
+        std::array<std::uint8_t, headerSize> header{};
+        queue.read(0, header);
+
+        const NetAddress<4> address{{header[0], header[1], header[2], header[3]}};
+        const auto port = byte::to<std::uint16_t>(header[4], header[5]);
+        const std::uint16_t datagramSize = std::min<std::uint16_t>(byte::to<std::uint16_t>(header[6], header[7]), queue.available() - headerSize);
+        const std::uint16_t size = std::min<std::uint16_t>(datagramSize, buffer.size());
+
+        if (size > 0)
+        {
+            queue.read(headerSize, buffer.first(size));
+        }
+
+        queue.consume(headerSize + datagramSize);
+
+        return {Status::ok, address, port, size};
+    }
+
+    SocketStatus UdpSocket::getStatus() const
+    {
+        return device.readSocketStatusRegister(handle);
+    }
+
+    void UdpSocket::closeImpl()
+    {
+        queue.reset();
+        device.executeSocketCommand(handle, SocketCommand::close);
+        device.writeSocketInterruptRegister(handle, SocketInterrupt{0xff});
+    }
+
+}
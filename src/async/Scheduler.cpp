@@ -0,0 +1,78 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "async/Scheduler.h"
+
+namespace eth::async
+{
+
+    Scheduler::Scheduler()
+        : waiters{}
+    {
+    }
+
+    bool Scheduler::wait(std::coroutine_handle<> handle, PollFn pollFn, void* awaiter)
+    {
+        for (auto& waiter : waiters)
+        {
+            if (!waiter.handle)
+            {
+                waiter = Waiter{handle, pollFn, awaiter};
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::size_t Scheduler::poll()
+    {
+        std::size_t resumed{0};
+
+        for (auto& waiter : waiters)
+        {
+            if (waiter.handle && waiter.poll(waiter.awaiter))
+            {
+                const auto handle = waiter.handle;
+                waiter = Waiter{};
+                handle.resume();
+                ++resumed;
+            }
+        }
+
+        return resumed;
+    }
+
+    std::size_t Scheduler::pending() const noexcept
+    {
+        std::size_t count{0};
+
+        for (const auto& waiter : waiters)
+        {
+            if (waiter.handle)
+            {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+}
@@ -0,0 +1,84 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "async/Task.h"
+#include <array>
+
+namespace eth::async
+{
+    namespace
+    {
+        struct Frame
+        {
+            alignas(std::max_align_t) std::array<std::byte, frameSize> storage;
+            bool used;
+        };
+
+        std::array<Frame, maxFrames> frames{};
+    }
+
+
+    void* allocateFrame(std::size_t size) noexcept
+    {
+        if (size > frameSize)
+        {
+            return nullptr;
+        }
+
+        for (auto& frame : frames)
+        {
+            if (frame.used == false)
+            {
+                frame.used = true;
+                return frame.storage.data();
+            }
+        }
+
+        return nullptr;
+    }
+
+    void deallocateFrame(void* frame) noexcept
+    {
+        for (auto& f : frames)
+        {
+            if (f.storage.data() == frame)
+            {
+                f.used = false;
+                return;
+            }
+        }
+    }
+
+    std::size_t framesInUse() noexcept
+    {
+        std::size_t count{0};
+
+        for (const auto& frame : frames)
+        {
+            if (frame.used)
+            {
+                ++count;
+            }
+        }
+
+        return count;
+    }
+
+}
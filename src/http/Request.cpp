@@ -0,0 +1,281 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "http/Request.h"
+#include "Socket.h"
+#include <algorithm>
+#include <charconv>
+
+namespace eth::http
+{
+    namespace
+    {
+        constexpr char toLower(char c)
+        {
+            return ((c >= 'A') && (c <= 'Z')) ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        constexpr Method toMethod(std::string_view value)
+        {
+            if (value == "GET")
+            {
+                return Method::get;
+            }
+            if (value == "HEAD")
+            {
+                return Method::head;
+            }
+            if (value == "POST")
+            {
+                return Method::post;
+            }
+            if (value == "PUT")
+            {
+                return Method::put;
+            }
+            if (value == "DELETE")
+            {
+                return Method::del;
+            }
+            return Method::unknown;
+        }
+
+        constexpr bool isWhitespace(char c)
+        {
+            return (c == ' ') || (c == '\t');
+        }
+    }
+
+
+    std::uint16_t Request::readBody(std::span<std::uint8_t> buffer)
+    {
+        const auto size = std::min<std::size_t>(buffer.size(), remainingBody());
+
+        if ((socket == nullptr) || (size == 0))
+        {
+            return 0;
+        }
+
+        const auto result = socket->tryReceive(buffer.first(size));
+        bodyRead += result.size;
+
+        return result.size;
+    }
+
+
+    RequestParser::RequestParser()
+        : state(State::method), parseResult(Result::incomplete), method(Method::unknown), keepAlive(true),
+          contentLength(0), hasContentLength(false), transferEncoded(false), token{}, path{}, headerName{}, headerValue{}, headerValueTruncated(false)
+    {
+    }
+
+    std::size_t RequestParser::parse(std::span<const std::uint8_t> data)
+    {
+        std::size_t consumed{0};
+
+        while ((consumed < data.size()) && (parseResult == Result::incomplete))
+        {
+            parse(static_cast<char>(data[consumed]));
+            ++consumed;
+        }
+
+        return consumed;
+    }
+
+    void RequestParser::reset() noexcept
+    {
+        state = State::method;
+        parseResult = Result::incomplete;
+        method = Method::unknown;
+        keepAlive = true;
+        contentLength = 0;
+        hasContentLength = false;
+        transferEncoded = false;
+        token.size = 0;
+        path.size = 0;
+        headerName.size = 0;
+        headerValue.size = 0;
+        headerValueTruncated = false;
+    }
+
+    Request RequestParser::request() const noexcept
+    {
+        return {method, path.view(), keepAlive, contentLength, 0, nullptr};
+    }
+
+    void RequestParser::parse(char c)
+    {
+        switch (state)
+        {
+            case State::method:
+                if (c == ' ')
+                {
+                    method = toMethod(token.view());
+                    token.size = 0;
+                    state = State::path;
+                }
+                else if ((c == '\r') || (c == '\n') || (token.append(c) == false))
+                {
+                    fail(Result::badRequest);
+                }
+                break;
+            case State::path:
+                if ((c == ' ') && (path.size > 0))
+                {
+                    state = State::version;
+                }
+                else if ((c == ' ') || (c == '\r') || (c == '\n'))
+                {
+                    fail(Result::badRequest);
+                }
+                else if (path.append(c) == false)
+                {
+                    fail(Result::uriTooLong);
+                }
+                break;
+            case State::version:
+                if (c == '\n')
+                {
+                    if (token.view() == "HTTP/1.0")
+                    {
+                        keepAlive = false;
+                    }
+                    else if (token.view() != "HTTP/1.1")
+                    {
+                        fail(Result::badRequest);
+                        break;
+                    }
+
+                    state = State::headerStart;
+                }
+                else if ((c != '\r') && (token.append(c) == false))
+                {
+                    fail(Result::badRequest);
+                }
+                break;
+            case State::headerStart:
+                if (c == '\n')
+                {
+                    finishHeaders();
+                }
+                else if (c != '\r')
+                {
+                    headerName.size = 0;
+                    headerValue.size = 0;
+                    headerValueTruncated = false;
+                    headerName.append(toLower(c));
+                    state = State::headerName;
+                }
+                break;
+            case State::headerName:
+                if (c == ':')
+                {
+                    state = State::headerValueStart;
+                }
+                else if (c == '\n')
+                {
+                    fail(Result::badRequest);
+                }
+                else
+                {
+                    headerName.append(toLower(c));
+                }
+                break;
+            case State::headerValueStart:
+                if (isWhitespace(c))
+                {
+                    break;
+                }
+                state = State::headerValue;
+                [[fallthrough]];
+            case State::headerValue:
+                if (c == '\n')
+                {
+                    finishHeader();
+                }
+                else if ((c != '\r') && (headerValue.append(toLower(c)) == false))
+                {
+                    headerValueTruncated = true;
+                }
+                break;
+            case State::done:
+                break;
+        }
+    }
+
+    void RequestParser::finishHeader()
+    {
+        state = State::headerStart;
+        const auto name = headerName.view();
+        auto value = headerValue.view();
+
+        while (!value.empty() && isWhitespace(value.back()))
+        {
+            value.remove_suffix(1);
+        }
+
+        if (name == "content-length")
+        {
+            const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), contentLength);
+
+            if ((error != std::errc{}) || (end != (value.data() + value.size())) || value.empty() || headerValueTruncated)
+            {
+                fail(Result::badRequest);
+            }
+
+            hasContentLength = true;
+        }
+        else if (name == "transfer-encoding")
+        {
+            transferEncoded = true;
+        }
+        else if ((name == "connection") && (headerValueTruncated == false))
+        {
+            if (value == "close")
+            {
+                keepAlive = false;
+            }
+            else if (value == "keep-alive")
+            {
+                keepAlive = true;
+            }
+        }
+    }
+
+    void RequestParser::finishHeaders()
+    {
+        if (transferEncoded == true)
+        {
+            fail(hasContentLength ? Result::notImplemented : Result::lengthRequired);
+        }
+        else
+        {
+            state = State::done;
+            parseResult = Result::complete;
+        }
+    }
+
+    void RequestParser::fail(Result reason) noexcept
+    {
+        state = State::done;
+        parseResult = reason;
+    }
+
+}
@@ -0,0 +1,286 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "http/Response.h"
+#include "Socket.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <iterator>
+
+namespace eth::http
+{
+    namespace
+    {
+        std::span<const std::uint8_t> asBytes(std::string_view text)
+        {
+            return {reinterpret_cast<const std::uint8_t*>(text.data()), text.size()};
+        }
+
+        constexpr std::string_view statusLine(StatusCode status)
+        {
+            switch (status)
+            {
+                case StatusCode::ok:
+                    return "HTTP/1.1 200 OK\r\n";
+                case StatusCode::noContent:
+                    return "HTTP/1.1 204 No Content\r\n";
+                case StatusCode::badRequest:
+                    return "HTTP/1.1 400 Bad Request\r\n";
+                case StatusCode::notFound:
+                    return "HTTP/1.1 404 Not Found\r\n";
+                case StatusCode::methodNotAllowed:
+                    return "HTTP/1.1 405 Method Not Allowed\r\n";
+                case StatusCode::lengthRequired:
+                    return "HTTP/1.1 411 Length Required\r\n";
+                case StatusCode::uriTooLong:
+                    return "HTTP/1.1 414 URI Too Long\r\n";
+                case StatusCode::notImplemented:
+                    return "HTTP/1.1 501 Not Implemented\r\n";
+                default:
+                    return "HTTP/1.1 500 Internal Server Error\r\n";
+            }
+        }
+
+        constexpr bool hasBody(StatusCode status)
+        {
+            const auto code = static_cast<std::uint16_t>(status);
+            return (code >= 200) && (code != 204) && (code != 304);
+        }
+
+        constexpr std::string_view contentTypeField{"Content-Type: "};
+        constexpr std::string_view contentLengthField{"\r\nContent-Length: "};
+        constexpr std::string_view chunkedField{"\r\nTransfer-Encoding: chunked"};
+        constexpr std::string_view keepAliveField{"\r\nConnection: keep-alive\r\n\r\n"};
+        constexpr std::string_view closeField{"\r\nConnection: close\r\n\r\n"};
+        constexpr std::string_view lineEnd{"\r\n"};
+        constexpr std::string_view lastChunk{"0\r\n\r\n"};
+
+        using NumberBuffer = std::array<char, 12>;
+
+        std::span<const std::uint8_t> toChars(NumberBuffer& buffer, std::size_t value, int base)
+        {
+            const auto [end, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, base);
+            return asBytes({buffer.data(), static_cast<std::size_t>(end - buffer.data())});
+        }
+    }
+
+
+    OutputBuffer::OutputBuffer()
+        : data{}, head(0), tail(0)
+    {
+    }
+
+    bool OutputBuffer::append(std::span<const std::span<const std::uint8_t>> segments, std::size_t skip)
+    {
+        std::size_t size{0};
+
+        for (const auto& segment : segments)
+        {
+            size += segment.size();
+        }
+
+        size -= skip;
+
+        if ((tail + size) > capacity)
+        {
+            std::copy(std::next(data.begin(), static_cast<std::ptrdiff_t>(head)),
+                      std::next(data.begin(), static_cast<std::ptrdiff_t>(tail)), data.begin());
+            tail -= head;
+            head = 0;
+        }
+
+        if ((tail + size) > capacity)
+        {
+            return false;
+        }
+
+        for (const auto& segment : segments)
+        {
+            const auto part = segment.subspan(std::min(skip, segment.size()));
+            skip -= segment.size() - part.size();
+            std::copy(part.begin(), part.end(), std::next(data.begin(), static_cast<std::ptrdiff_t>(tail)));
+            tail += part.size();
+        }
+
+        return true;
+    }
+
+    Socket::Status OutputBuffer::flush(Socket& socket)
+    {
+        if (isEmpty() == true)
+        {
+            return Socket::Status::ok;
+        }
+
+        const auto result = socket.trySend(std::span{data}.subspan(head, tail - head));
+
+        if (result.status == Socket::Status::closed)
+        {
+            return Socket::Status::closed;
+        }
+
+        head += result.size;
+
+        if (isEmpty() == false)
+        {
+            return Socket::Status::wouldBlock;
+        }
+
+        head = 0;
+        tail = 0;
+        return Socket::Status::ok;
+    }
+
+
+    Response::Response(Socket& s, OutputBuffer& buffer, bool keepAliveConnection, bool headersOnly)
+        : socket(s), output(buffer), keepAlive(keepAliveConnection), omitBody(headersOnly), started(false),
+          finished(false), failed(false)
+    {
+    }
+
+    bool Response::begin(StatusCode status, std::string_view contentType)
+    {
+        if (started == true)
+        {
+            return false;
+        }
+
+        return sendHeader(status, contentType, {}, {});
+    }
+
+    bool Response::write(std::span<const std::uint8_t> data)
+    {
+        if ((started == false) || (finished == true))
+        {
+            return false;
+        }
+
+        if (omitBody == true)
+        {
+            return true;
+        }
+
+        while (!data.empty())
+        {
+            const auto chunk = data.first(std::min(data.size(), maxChunkSize));
+            NumberBuffer buffer;
+            const std::array<std::span<const std::uint8_t>, 4> segments{
+                {toChars(buffer, chunk.size(), 16), asBytes(lineEnd), chunk, asBytes(lineEnd)}};
+
+            if (transmit(segments) == false)
+            {
+                return false;
+            }
+
+            data = data.subspan(chunk.size());
+        }
+
+        return true;
+    }
+
+    bool Response::write(std::string_view text)
+    {
+        return write(asBytes(text));
+    }
+
+    bool Response::end()
+    {
+        if ((started == false) || (finished == true))
+        {
+            return false;
+        }
+
+        finished = true;
+
+        if (omitBody == true)
+        {
+            return true;
+        }
+
+        const std::array<std::span<const std::uint8_t>, 1> segments{{asBytes(lastChunk)}};
+        return transmit(segments);
+    }
+
+    bool Response::send(StatusCode status, std::string_view contentType, std::string_view body)
+    {
+        if (started == true)
+        {
+            return false;
+        }
+
+        NumberBuffer buffer;
+        finished = true;
+
+        return sendHeader(status, contentType, toChars(buffer, body.size(), 10), asBytes(body));
+    }
+
+    bool Response::sendHeader(StatusCode status, std::string_view contentType, std::span<const std::uint8_t> length,
+                              std::span<const std::uint8_t> body)
+    {
+        started = true;
+
+        const auto connectionField = (keepAlive ? keepAliveField : closeField);
+
+        if (hasBody(status) == false)
+        {
+            omitBody = true;
+            const std::array<std::span<const std::uint8_t>, 2> segments{
+                {asBytes(statusLine(status)), asBytes(connectionField.substr(lineEnd.size()))}};
+
+            return transmit(segments);
+        }
+
+        const auto isChunked = length.empty();
+        const std::array<std::span<const std::uint8_t>, 7> segments{
+            {asBytes(statusLine(status)),
+             asBytes(contentTypeField),
+             asBytes(contentType),
+             asBytes(isChunked ? chunkedField : contentLengthField),
+             length,
+             asBytes(connectionField),
+             (omitBody ? std::span<const std::uint8_t>{} : body)}};
+
+        return transmit(segments);
+    }
+
+    bool Response::transmit(std::span<const std::span<const std::uint8_t>> segments)
+    {
+        if (failed == true)
+        {
+            return false;
+        }
+
+        auto result = Socket::Result{output.flush(socket), 0};
+
+        if (result.status == Socket::Status::ok)
+        {
+            result = socket.trySend(segments);
+        }
+
+        if ((result.status == Socket::Status::closed) || (output.append(segments, result.size) == false))
+        {
+            failed = true;
+        }
+
+        return failed == false;
+    }
+
+}
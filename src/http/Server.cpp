@@ -0,0 +1,253 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "http/Server.h"
+#include "NetDevice.h"
+#include <algorithm>
+
+namespace eth::http
+{
+    namespace
+    {
+        constexpr bool isConnected(SocketStatus status)
+        {
+            return (status == SocketStatus::established) || (status == SocketStatus::closeWait);
+        }
+
+        constexpr std::string_view textPlain{"text/plain"};
+    }
+
+
+    Connection::Connection(Socket& s, std::span<const Route> routeTable)
+        : connection(s), routes(routeTable), parser(), output(), pendingBody(0), state(State::open)
+    {
+    }
+
+    Socket::Status Connection::poll()
+    {
+        if (const auto drained = drain(); drained != Socket::Status::ok)
+        {
+            return drained;
+        }
+
+        const auto status = connection.getStatus();
+
+        if (isConnected(status) == false)
+        {
+            return Socket::Status::closed;
+        }
+
+        if (discardBody() == false)
+        {
+            return idle(status);
+        }
+
+        const auto view = connection.peek();
+
+        if (view.size == 0)
+        {
+            return idle(status);
+        }
+
+        std::array<std::uint8_t, windowSize> window;
+        std::uint16_t offset{0};
+
+        while ((offset < view.size) && (parser.result() == RequestParser::Result::incomplete))
+        {
+            const auto size = connection.read(view, offset, window);
+            offset += parser.parse(std::span{window}.first(size));
+        }
+
+        connection.consume(view, offset);
+
+        switch (parser.result())
+        {
+            case RequestParser::Result::incomplete:
+                return Socket::Status::ok;
+            case RequestParser::Result::complete:
+                dispatch();
+                break;
+            case RequestParser::Result::uriTooLong:
+                reject(StatusCode::uriTooLong);
+                break;
+            case RequestParser::Result::lengthRequired:
+                reject(StatusCode::lengthRequired);
+                break;
+            case RequestParser::Result::notImplemented:
+                reject(StatusCode::notImplemented);
+                break;
+            default:
+                reject(StatusCode::badRequest);
+                break;
+        }
+
+        return drain();
+    }
+
+    bool Connection::discardBody()
+    {
+        while (pendingBody > 0)
+        {
+            const auto view = connection.peek();
+
+            if (view.size == 0)
+            {
+                return false;
+            }
+
+            const auto size = static_cast<std::uint16_t>(std::min<std::uint32_t>(view.size, pendingBody));
+            connection.consume(view, size);
+            pendingBody -= size;
+        }
+
+        return true;
+    }
+
+    void Connection::dispatch()
+    {
+        auto request = parser.request();
+        request.socket = &connection;
+        const auto isHead = (request.method == Method::head);
+        Response response{connection, output, request.keepAlive, isHead};
+        const auto* route = findRoute(routes, request.path, request.method);
+
+        if ((route == nullptr) && isHead)
+        {
+            route = findRoute(routes, request.path, Method::get);
+        }
+
+        if (route != nullptr)
+        {
+            route->handler(request, response);
+        }
+        else
+        {
+            const auto pathKnown = hasPath(routes, request.path);
+            response.send(pathKnown ? StatusCode::methodNotAllowed : StatusCode::notFound, textPlain, "");
+        }
+
+        if (response.isStarted() == false)
+        {
+            response.send(StatusCode::noContent, textPlain, "");
+        }
+        else if (response.isFinished() == false)
+        {
+            response.end();
+        }
+
+        pendingBody = request.remainingBody();
+        parser.reset();
+
+        if ((request.keepAlive == false) || response.isFailed())
+        {
+            state = State::closing;
+        }
+    }
+
+    void Connection::reject(StatusCode status)
+    {
+        Response response{connection, output, false};
+        response.send(status, textPlain, "");
+        parser.reset();
+        state = State::closing;
+    }
+
+    Socket::Status Connection::idle(SocketStatus status)
+    {
+        if (status == SocketStatus::closeWait)
+        {
+            state = State::closing;
+            return drain();
+        }
+
+        return Socket::Status::wouldBlock;
+    }
+
+    Socket::Status Connection::drain()
+    {
+        if (state != State::disconnecting)
+        {
+            const auto flushed = output.flush(connection);
+
+            if ((flushed != Socket::Status::ok) || (state == State::open))
+            {
+                return flushed;
+            }
+
+            state = State::disconnecting;
+            connection.startDisconnect();
+        }
+
+        switch (connection.pollDisconnect())
+        {
+            case Socket::Status::wouldBlock:
+                return Socket::Status::wouldBlock;
+            case Socket::Status::timeout:
+                connection.close();
+                return Socket::Status::closed;
+            default:
+                return Socket::Status::closed;
+        }
+    }
+
+
+    Server::Server(NetDevice& dev, std::uint16_t port, std::span<const Route> routeTable, std::uint8_t backlog)
+        : tcpServer(dev, port, backlog), routes(routeTable), connections{}
+    {
+    }
+
+    Socket::Status Server::listen()
+    {
+        return tcpServer.listen();
+    }
+
+    std::size_t Server::poll()
+    {
+        for (auto* socket = tcpServer.accept(); socket != nullptr; socket = tcpServer.accept())
+        {
+            auto slot = std::find_if(connections.begin(), connections.end(), [](const auto& c)
+                                     { return c.has_value() == false; });
+            slot->emplace(*socket, routes);
+        }
+
+        std::size_t active{0};
+
+        for (auto& connection : connections)
+        {
+            if (connection.has_value() == false)
+            {
+                continue;
+            }
+
+            if (connection->poll() == Socket::Status::closed)
+            {
+                tcpServer.release(connection->socket());
+                connection.reset();
+            }
+            else
+            {
+                ++active;
+            }
+        }
+
+        return active;
+    }
+
+}
@@ -0,0 +1,378 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mqtt/Client.h"
+#include "Platform.h"
+#include <algorithm>
+
+namespace eth::mqtt
+{
+    namespace
+    {
+        constexpr std::size_t maxBodySize{2};
+
+        constexpr std::uint32_t elapsed(std::uint32_t since, std::uint32_t now)
+        {
+            return now - since;
+        }
+
+        constexpr std::uint16_t nextPacketId(std::uint16_t id)
+        {
+            const auto next = static_cast<std::uint16_t>(id + 1);
+            return (next == 0 ? std::uint16_t{1} : next);
+        }
+    }
+
+
+    Client::Client(Socket& s, const Options& opts)
+        : socket(s), options(opts), state(State::disconnected), sessionPresent(false), pingPending(false), packetId(0),
+          lastSent(0), requestSent(0), head(0), sent(0), tail(0), slots{}
+    {
+    }
+
+    Socket::Status Client::connect(NetAddress<4> address, std::uint16_t port)
+    {
+        if (socket.open(Protocol::tcp, options.localPort, 0) != Socket::Status::ok)
+        {
+            return Socket::Status::failed;
+        }
+
+        if (const auto status = socket.connect(address, port); status != Socket::Status::ok)
+        {
+            return closeConnection(status);
+        }
+
+        std::array<std::uint8_t, maxPacketSize> buffer;
+        const auto size = encodeConnect(buffer, {options.clientId, options.keepAlive, options.cleanSession});
+
+        if (size == 0)
+        {
+            return closeConnection(Socket::Status::failed);
+        }
+
+        if (sendPacket(std::span{buffer}.first(size)) == false)
+        {
+            return closeConnection(Socket::Status::closed);
+        }
+
+        state = State::connecting;
+        requestSent = lastSent;
+        pingPending = false;
+
+        return Socket::Status::ok;
+    }
+
+    void Client::disconnect()
+    {
+        if (state == State::connected)
+        {
+            sendPacket(disconnectRequest);
+            socket.disconnect();
+        }
+
+        closeConnection(Socket::Status::closed);
+    }
+
+    Socket::Status Client::publish(std::string_view topic, std::span<const std::uint8_t> payload, QoS qos)
+    {
+        if (pending() == maxInflight)
+        {
+            return Socket::Status::wouldBlock;
+        }
+
+        auto& slot = slotAt(tail);
+        const std::uint16_t id = (qos == QoS::atLeastOnce ? nextPacketId(packetId) : 0);
+        const auto size = encodePublish(slot.packet, topic, payload, qos, id);
+
+        if (size == 0)
+        {
+            return Socket::Status::failed;
+        }
+
+        if (qos == QoS::atLeastOnce)
+        {
+            packetId = id;
+        }
+
+        slot.size = static_cast<std::uint16_t>(size);
+        slot.packetId = id;
+        slot.qos = qos;
+        slot.state = SlotState::queued;
+        ++tail;
+
+        return Socket::Status::ok;
+    }
+
+    Socket::Status Client::flush()
+    {
+        if (state != State::connected)
+        {
+            return Socket::Status::wouldBlock;
+        }
+
+        std::array<std::span<const std::uint8_t>, maxInflight> segments;
+        std::size_t count{0};
+
+        for (auto i = sent; i < tail; ++i)
+        {
+            const auto& slot = slotAt(i);
+
+            if (slot.state == SlotState::queued)
+            {
+                segments[count++] = std::span{slot.packet}.first(slot.size);
+            }
+        }
+
+        if ((count > 0) && (sendSegments(std::span{segments}.first(count)) == false))
+        {
+            return Socket::Status::closed;
+        }
+
+        for (; sent < tail; ++sent)
+        {
+            auto& slot = slotAt(sent);
+
+            if (slot.state == SlotState::queued)
+            {
+                slot.state = (slot.qos == QoS::atLeastOnce ? SlotState::awaitingAck : SlotState::free);
+            }
+        }
+
+        releaseAcknowledged();
+
+        return Socket::Status::ok;
+    }
+
+    Socket::Status Client::poll()
+    {
+        if (state == State::disconnected)
+        {
+            return Socket::Status::closed;
+        }
+
+        const auto status = socket.getStatus();
+
+        if ((status == SocketStatus::established) || (status == SocketStatus::closeWait))
+        {
+            if (receive() == false)
+            {
+                return closeConnection(Socket::Status::failed);
+            }
+        }
+
+        if (status != SocketStatus::established)
+        {
+            return closeConnection(Socket::Status::closed);
+        }
+
+        if (state == State::connecting)
+        {
+            if (elapsed(requestSent, platform::milliseconds()) >= options.responseTimeout)
+            {
+                return closeConnection(Socket::Status::timeout);
+            }
+
+            return Socket::Status::wouldBlock;
+        }
+
+        if (flush() != Socket::Status::ok)
+        {
+            return closeConnection(Socket::Status::closed);
+        }
+
+        return keepConnectionAlive();
+    }
+
+    bool Client::receive()
+    {
+        const auto view = socket.peek();
+        std::uint16_t offset{0};
+
+        while (offset < view.size)
+        {
+            std::array<std::uint8_t, maxFixedHeaderSize> headerData{};
+            const auto headerSize = socket.read(view, offset, headerData);
+            FixedHeader header{};
+
+            if (decodeFixedHeader(std::span{headerData}.first(headerSize), header) == 0)
+            {
+                if (headerSize == maxFixedHeaderSize)
+                {
+                    return false;
+                }
+
+                break;
+            }
+
+            const auto total = header.size + header.remainingLength;
+
+            if (total > static_cast<std::size_t>(view.size - offset))
+            {
+                break;
+            }
+
+            std::array<std::uint8_t, maxBodySize> body{};
+            const auto bodySize = std::min<std::size_t>(header.remainingLength, body.size());
+            socket.read(view, static_cast<std::uint16_t>(offset + header.size), std::span{body}.first(bodySize));
+
+            if (handle(header, std::span{body}.first(bodySize)) == false)
+            {
+                return false;
+            }
+
+            offset = static_cast<std::uint16_t>(offset + total);
+        }
+
+        socket.consume(view, offset);
+        return true;
+    }
+
+    bool Client::handle(const FixedHeader& header, std::span<const std::uint8_t> body)
+    {
+        switch (header.type)
+        {
+            case PacketType::connack:
+                if ((header.remainingLength != 2) || (body[1] != 0))
+                {
+                    return false;
+                }
+
+                sessionPresent = ((body[0] & 0x01) != 0);
+                state = State::connected;
+                resumeSession();
+                break;
+            case PacketType::puback:
+                if (header.remainingLength != 2)
+                {
+                    return false;
+                }
+
+                acknowledge(static_cast<std::uint16_t>((body[0] << 8) | body[1]));
+                break;
+            case PacketType::pingresp:
+                pingPending = false;
+                break;
+            default:
+                break;
+        }
+
+        return true;
+    }
+
+    void Client::acknowledge(std::uint16_t id)
+    {
+        for (auto i = head; i < sent; ++i)
+        {
+            auto& slot = slotAt(i);
+
+            if ((slot.state == SlotState::awaitingAck) && (slot.packetId == id))
+            {
+                slot.state = SlotState::free;
+                break;
+            }
+        }
+
+        releaseAcknowledged();
+    }
+
+    void Client::resumeSession()
+    {
+        for (auto i = head; i < sent; ++i)
+        {
+            auto& slot = slotAt(i);
+
+            if (slot.state == SlotState::awaitingAck)
+            {
+                slot.state = SlotState::queued;
+
+                if (options.cleanSession == false)
+                {
+                    slot.packet[0] = static_cast<std::uint8_t>(slot.packet[0] | dupFlag);
+                }
+            }
+        }
+
+        sent = head;
+    }
+
+    void Client::releaseAcknowledged() noexcept
+    {
+        while ((head < sent) && (slotAt(head).state == SlotState::free))
+        {
+            ++head;
+        }
+    }
+
+    bool Client::sendPacket(std::span<const std::uint8_t> packet)
+    {
+        return sendSegments(std::span{&packet, 1});
+    }
+
+    bool Client::sendSegments(std::span<const std::span<const std::uint8_t>> segments)
+    {
+        if (socket.send(segments) == 0)
+        {
+            return false;
+        }
+
+        lastSent = platform::milliseconds();
+        return true;
+    }
+
+    Socket::Status Client::keepConnectionAlive()
+    {
+        if (options.keepAlive == 0)
+        {
+            return Socket::Status::ok;
+        }
+
+        const auto now = platform::milliseconds();
+
+        if (pingPending == true)
+        {
+            if (elapsed(requestSent, now) >= options.responseTimeout)
+            {
+                return closeConnection(Socket::Status::timeout);
+            }
+        }
+        else if (elapsed(lastSent, now) >= (options.keepAlive * 1000u))
+        {
+            if (sendPacket(pingRequest) == false)
+            {
+                return closeConnection(Socket::Status::closed);
+            }
+
+            pingPending = true;
+            requestSent = lastSent;
+        }
+
+        return Socket::Status::ok;
+    }
+
+    Socket::Status Client::closeConnection(Socket::Status reason)
+    {
+        socket.close();
+        state = State::disconnected;
+        pingPending = false;
+
+        return reason;
+    }
+
+}
@@ -0,0 +1,181 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mqtt/Packet.h"
+#include "Byte.h"
+#include <algorithm>
+
+namespace eth::mqtt
+{
+    namespace
+    {
+        constexpr std::uint32_t maxRemainingLength{268'435'455};
+        constexpr std::array<std::uint8_t, 7> protocolName{{0x00, 0x04, 'M', 'Q', 'T', 'T', 0x04}};
+        constexpr std::uint8_t cleanSessionFlag{0x02};
+
+
+        class PacketWriter
+        {
+        public:
+            explicit PacketWriter(std::span<std::uint8_t> data)
+                : buffer(data), position(0), overflow(false)
+            {
+            }
+
+            void put(std::uint8_t value)
+            {
+                put(std::span<const std::uint8_t>{&value, 1});
+            }
+
+            void put(std::span<const std::uint8_t> data)
+            {
+                if (data.size() > (buffer.size() - std::min(position, buffer.size())))
+                {
+                    overflow = true;
+                    return;
+                }
+
+                std::copy(data.begin(), data.end(), std::next(buffer.begin(), position));
+                position += data.size();
+            }
+
+            void putWord(std::uint16_t value)
+            {
+                put(byte::get<1>(value));
+                put(byte::get<0>(value));
+            }
+
+            void putString(std::string_view value)
+            {
+                putWord(static_cast<std::uint16_t>(value.size()));
+                put({reinterpret_cast<const std::uint8_t*>(value.data()), value.size()});
+            }
+
+            void putRemainingLength(std::uint32_t value)
+            {
+                do
+                {
+                    auto encoded = static_cast<std::uint8_t>(value % 128);
+                    value /= 128;
+
+                    if (value > 0)
+                    {
+                        encoded = static_cast<std::uint8_t>(encoded | 0x80);
+                    }
+
+                    put(encoded);
+                } while (value > 0);
+            }
+
+            std::size_t size() const noexcept
+            {
+                return (overflow ? 0 : position);
+            }
+
+        private:
+            std::span<std::uint8_t> buffer;
+            std::size_t position;
+            bool overflow;
+        };
+
+        constexpr std::uint8_t makeType(PacketType type, std::uint8_t flags)
+        {
+            return static_cast<std::uint8_t>((static_cast<std::uint8_t>(type) << 4) | flags);
+        }
+
+        constexpr bool fitsString(std::string_view value)
+        {
+            return value.size() <= 0xffff;
+        }
+    }
+
+
+    std::size_t encodeConnect(std::span<std::uint8_t> buffer, const ConnectOptions& options)
+    {
+        if (fitsString(options.clientId) == false)
+        {
+            return 0;
+        }
+
+        const auto remainingLength = protocolName.size() + 1 + 2 + 2 + options.clientId.size();
+
+        PacketWriter writer{buffer};
+        writer.put(makeType(PacketType::connect, 0));
+        writer.putRemainingLength(static_cast<std::uint32_t>(remainingLength));
+        writer.put(protocolName);
+        writer.put(options.cleanSession ? cleanSessionFlag : std::uint8_t{0});
+        writer.putWord(options.keepAlive);
+        writer.putString(options.clientId);
+
+        return writer.size();
+    }
+
+    std::size_t encodePublish(std::span<std::uint8_t> buffer, std::string_view topic, std::span<const std::uint8_t> payload,
+                              QoS qos, std::uint16_t packetId)
+    {
+        const std::size_t idSize = (qos == QoS::atMostOnce ? 0 : 2);
+        const auto remainingLength = 2 + topic.size() + idSize + payload.size();
+
+        if ((fitsString(topic) == false) || (remainingLength > maxRemainingLength))
+        {
+            return 0;
+        }
+
+        PacketWriter writer{buffer};
+        writer.put(makeType(PacketType::publish, static_cast<std::uint8_t>(static_cast<std::uint8_t>(qos) << 1)));
+        writer.putRemainingLength(static_cast<std::uint32_t>(remainingLength));
+        writer.putString(topic);
+
+        if (qos != QoS::atMostOnce)
+        {
+            writer.putWord(packetId);
+        }
+
+        writer.put(payload);
+
+        return writer.size();
+    }
+
+    std::size_t decodeFixedHeader(std::span<const std::uint8_t> data, FixedHeader& header)
+    {
+        if (data.size() < 2)
+        {
+            return 0;
+        }
+
+        std::uint32_t length{0};
+        std::uint32_t multiplier{1};
+
+        for (std::size_t i = 1; (i < data.size()) && (i < maxFixedHeaderSize); ++i)
+        {
+            length += (data[i] & 0x7fu) * multiplier;
+            multiplier *= 128;
+
+            if ((data[i] & 0x80u) == 0)
+            {
+                header = {static_cast<PacketType>(data[0] >> 4), static_cast<std::uint8_t>(data[0] & 0x0f), length, i + 1};
+                return header.size;
+            }
+        }
+
+        return 0;
+    }
+
+}
@@ -0,0 +1,223 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spi/SpiDma.h"
+#include "spi/SpiWriter.h"
+#include "Statistics.h"
+#include <type_traits>
+
+namespace eth::spi
+{
+    namespace
+    {
+        const std::array<DMA_Stream_TypeDef*, 16> dmaStreams{{DMA1_Stream0, DMA1_Stream1, DMA1_Stream2, DMA1_Stream3,
+                                                              DMA1_Stream4, DMA1_Stream5, DMA1_Stream6, DMA1_Stream7,
+                                                              DMA2_Stream0, DMA2_Stream1, DMA2_Stream2, DMA2_Stream3,
+                                                              DMA2_Stream4, DMA2_Stream5, DMA2_Stream6, DMA2_Stream7}};
+
+        DMA_Stream_TypeDef* toStream(DmaController controller, std::uint8_t stream)
+        {
+            constexpr std::size_t streamsPerController{8};
+            return dmaStreams[(static_cast<std::size_t>(controller) * streamsPerController) + stream];
+        }
+
+        void initDma(DMA_HandleTypeDef& dma, DMA_Stream_TypeDef* stream, std::uint32_t channel, std::uint32_t direction)
+        {
+            dma.Instance = stream;
+            dma.Init.Channel = channel;
+            dma.Init.Direction = direction;
+            dma.Init.PeriphInc = DMA_PINC_DISABLE;
+            dma.Init.MemInc = DMA_MINC_ENABLE;
+            dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+            dma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+            dma.Init.Mode = DMA_NORMAL;
+            dma.Init.Priority = DMA_PRIORITY_HIGH;
+            dma.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+
+            HAL_DMA_Init(&dma);
+        }
+    }
+
+
+    SpiDma::SpiDma(SpiWriter& spiWriter, const DmaConfig& cfg)
+        : writer(spiWriter)
+    {
+        const auto [controller, transmitStream, receiveStream, channel] = cfg;
+        initDma(transmitDma, toStream(controller, transmitStream), channel, DMA_MEMORY_TO_PERIPH);
+        initDma(receiveDma, toStream(controller, receiveStream), channel, DMA_PERIPH_TO_MEMORY);
+
+        auto* handle = &writer.nativeHandle();
+        __HAL_LINKDMA(handle, hdmatx, transmitDma);
+        __HAL_LINKDMA(handle, hdmarx, receiveDma);
+    }
+
+    bool SpiDma::startWrite(std::span<const WriteSegment> segments, Callback callback, void* context)
+    {
+        return start(segments, callback, context);
+    }
+
+    bool SpiDma::startRead(std::span<const ReadSegment> segments, Callback callback, void* context)
+    {
+        return start(segments, callback, context);
+    }
+
+    bool SpiDma::isBusy() const noexcept
+    {
+        return busy;
+    }
+
+    void SpiDma::handleTransmitInterrupt()
+    {
+        HAL_DMA_IRQHandler(&transmitDma);
+    }
+
+    void SpiDma::handleReceiveInterrupt()
+    {
+        HAL_DMA_IRQHandler(&receiveDma);
+    }
+
+    void SpiDma::onComplete(SPI_HandleTypeDef* hspi)
+    {
+        if (busy && (hspi == &writer.nativeHandle()))
+        {
+            onFrameComplete();
+        }
+    }
+
+    void SpiDma::onError(SPI_HandleTypeDef* hspi)
+    {
+        if (busy && (hspi == &writer.nativeHandle()))
+        {
+            writer.setSlaveSelect(SpiWriter::PinState::reset);
+            finish(false);
+        }
+    }
+
+    void SpiDma::onFrameComplete()
+    {
+        writer.setSlaveSelect(SpiWriter::PinState::reset);
+
+        const auto& transfer = transfers[transferIndex];
+
+        if (reading)
+        {
+            transfer.destination[position] = receiveFrame.back();
+        }
+
+        if (++position == transfer.size)
+        {
+            position = 0;
+            ++transferIndex;
+        }
+
+        if (transferIndex < transferCount)
+        {
+            startFrame();
+        }
+        else
+        {
+            finish(true);
+        }
+    }
+
+    template <class T>
+    bool SpiDma::start(std::span<const Segment<T>> segments, Callback callback, void* context)
+    {
+        if (busy || (segments.size() > maxSegments))
+        {
+            return false;
+        }
+
+        transferCount = 0;
+
+        for (const auto& segment : segments)
+        {
+            if (!segment.data.empty())
+            {
+                if constexpr (std::is_const_v<T>)
+                {
+                    transfers[transferCount++] = Transfer{segment.address, segment.data.data(), nullptr, segment.data.size()};
+                }
+                else
+                {
+                    transfers[transferCount++] = Transfer{segment.address, nullptr, segment.data.data(), segment.data.size()};
+                }
+            }
+        }
+
+        transferIndex = 0;
+        position = 0;
+        reading = !std::is_const_v<T>;
+        completionCallback = callback;
+        completionContext = context;
+
+        if (transferCount == 0)
+        {
+            finish(true);
+        }
+        else
+        {
+            busy = true;
+            startFrame();
+        }
+
+        return true;
+    }
+
+    void SpiDma::startFrame()
+    {
+        const auto& transfer = transfers[transferIndex];
+        const auto address = static_cast<std::uint16_t>(transfer.address + position);
+        auto* handle = &writer.nativeHandle();
+        stats::countSpiFrames(1);
+
+        writer.setSlaveSelect(SpiWriter::PinState::set);
+
+        HAL_StatusTypeDef result{HAL_OK};
+
+        if (reading)
+        {
+            transmitFrame = makePacket<OpCode::read>(address, std::uint8_t{0});
+            result = HAL_SPI_TransmitReceive_DMA(handle, transmitFrame.data(), receiveFrame.data(), transmitFrame.size());
+        }
+        else
+        {
+            transmitFrame = makePacket<OpCode::write>(address, transfer.source[position]);
+            result = HAL_SPI_Transmit_DMA(handle, transmitFrame.data(), transmitFrame.size());
+        }
+
+        if (result != HAL_OK)
+        {
+            writer.setSlaveSelect(SpiWriter::PinState::reset);
+            finish(false);
+        }
+    }
+
+    void SpiDma::finish(bool success)
+    {
+        busy = false;
+
+        if (completionCallback != nullptr)
+        {
+            completionCallback(completionContext, success);
+        }
+    }
+
+}
@@ -19,26 +19,30 @@
  */
 
 #include "spi/SpiWriter.h"
-#include "Byte.h"
+#include "spi/Packet.h"
+#include "Statistics.h"
+#include "Trace.h"
 #include <array>
+#include <algorithm>
+#include <iterator>
 #include <limits>
 
 namespace eth::spi
 {
     namespace
     {
-        enum class OpCode : std::uint8_t
-        {
-            read = 0x0f,
-            write = 0xf0
-        };
+        constexpr std::size_t framesPerBlock{32};
 
+        using FrameBuffer = std::array<std::uint8_t, packetSize * framesPerBlock>;
 
-        template <OpCode opcode, class... Ts>
-        constexpr auto makePacket(std::uint16_t address, Ts&&... params)
+        template <OpCode opcode, class DataFn>
+        void encodeFrames(FrameBuffer& frames, std::uint16_t address, std::size_t count, DataFn dataFn)
         {
-            using Type = std::array<std::uint8_t, 3 + sizeof...(Ts)>;
-            return Type{{static_cast<std::uint8_t>(opcode), byte::get<1>(address), byte::get<0>(address), std::forward<Ts>(params)...}};
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto packet = makePacket<opcode>(static_cast<std::uint16_t>(address + i), dataFn(i));
+                std::copy(packet.cbegin(), packet.cend(), std::next(frames.begin(), i * packetSize));
+            }
         }
 
         constexpr auto timeout = std::numeric_limits<std::uint32_t>::max();
@@ -92,7 +96,9 @@ namespace eth::spi
 
     void SpiWriter::write(std::uint16_t address, std::uint8_t data)
     {
+        const trace::Scope scope{trace::Probe::spiTransfer};
         auto packet = makePacket<OpCode::write>(address, data);
+        stats::countSpiFrames(1);
 
         SlaveSelect ss{this};
         HAL_SPI_Transmit(&handle, packet.data(), packet.size(), timeout);
@@ -100,15 +106,94 @@ namespace eth::spi
 
     std::uint8_t SpiWriter::read(std::uint16_t address)
     {
-        auto packet = makePacket<OpCode::read>(address);
+        const trace::Scope scope{trace::Probe::spiTransfer};
+        auto packet = makePacket<OpCode::read>(address, std::uint8_t{0});
+        std::array<std::uint8_t, packetSize> buffer{};
+        stats::countSpiFrames(1);
 
         SlaveSelect ss{this};
-        HAL_SPI_Transmit(&handle, packet.data(), packet.size(), timeout);
+        HAL_SPI_TransmitReceive(&handle, packet.data(), buffer.data(), packet.size(), timeout);
 
-        std::array<std::uint8_t, 1> buffer{{0}};
-        HAL_SPI_Receive(&handle, buffer.data(), buffer.size(), timeout);
+        return buffer.back();
+    }
+
+    void SpiWriter::writeBlock(std::uint16_t address, std::span<const std::uint8_t> data)
+    {
+        const trace::Scope scope{trace::Probe::spiBlockTransfer};
+        FrameBuffer frames;
+        stats::countSpiFrames(data.size());
 
-        return buffer[0];
+        while (!data.empty())
+        {
+            const auto count = std::min(data.size(), framesPerBlock);
+            encodeFrames<OpCode::write>(frames, address, count, [&data](std::size_t i)
+                                        { return data[i]; });
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                SlaveSelect ss{this};
+                HAL_SPI_Transmit(&handle, std::next(frames.data(), i * packetSize), packetSize, timeout);
+            }
+
+            address += count;
+            data = data.subspan(count);
+        }
+    }
+
+    void SpiWriter::readBlock(std::uint16_t address, std::span<std::uint8_t> data)
+    {
+        const trace::Scope scope{trace::Probe::spiBlockTransfer};
+        FrameBuffer frames;
+        FrameBuffer received;
+        stats::countSpiFrames(data.size());
+
+        while (!data.empty())
+        {
+            const auto count = std::min(data.size(), framesPerBlock);
+            encodeFrames<OpCode::read>(frames, address, count, []([[maybe_unused]] std::size_t i)
+                                       { return std::uint8_t{0}; });
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const auto offset = i * packetSize;
+                SlaveSelect ss{this};
+                HAL_SPI_TransmitReceive(&handle, std::next(frames.data(), offset), std::next(received.data(), offset), packetSize, timeout);
+            }
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                data[i] = received[(i * packetSize) + packetHeaderSize];
+            }
+
+            address += count;
+            data = data.subspan(count);
+        }
+    }
+
+    void SpiWriter::writeFrame(std::span<const std::uint8_t> header, std::span<const std::uint8_t> data)
+    {
+        const trace::Scope scope{trace::Probe::spiTransfer};
+        stats::countSpiFrames(1);
+        SlaveSelect ss{this};
+        HAL_SPI_Transmit(&handle, const_cast<std::uint8_t*>(header.data()), header.size(), timeout);
+
+        if (!data.empty())
+        {
+            HAL_SPI_Transmit(&handle, const_cast<std::uint8_t*>(data.data()), data.size(), timeout);
+        }
+    }
+
+    void SpiWriter::readFrame(std::span<const std::uint8_t> header, std::span<std::uint8_t> data)
+    {
+        const trace::Scope scope{trace::Probe::spiTransfer};
+        stats::countSpiFrames(1);
+        SlaveSelect ss{this};
+        HAL_SPI_Transmit(&handle, const_cast<std::uint8_t*>(header.data()), header.size(), timeout);
+
+        if (!data.empty())
+        {
+            HAL_SPI_Receive(&handle, data.data(), data.size(), timeout);
+        }
     }
 
     void SpiWriter::setSlaveSelect(PinState state)
@@ -123,4 +208,14 @@ namespace eth::spi
         return handle;
     }
 
+    GPIO_TypeDef& SpiWriter::slaveSelectPort() const noexcept
+    {
+        return *pinBlocks[static_cast<std::size_t>(std::get<1>(config))];
+    }
+
+    std::uint16_t SpiWriter::slaveSelectPin() const noexcept
+    {
+        return static_cast<std::uint16_t>(std::get<3>(config).Pin);
+    }
+
 }
@@ -0,0 +1,241 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "w5500/Device.h"
+#include "w5500/Registers.h"
+#include "spi/SpiWriter.h"
+#include "Statistics.h"
+#include "Trace.h"
+
+namespace eth::w5500
+{
+
+    namespace
+    {
+        enum class Access : std::uint8_t
+        {
+            read = 0x00,
+            write = 0x04
+        };
+
+        constexpr std::array<std::uint8_t, 3> makeHeader(std::uint8_t block, std::uint16_t address, Access access) noexcept
+        {
+            return {{byte::get<1>(address), byte::get<0>(address),
+                     static_cast<std::uint8_t>((block << 3) | static_cast<std::uint8_t>(access))}};
+        }
+    }
+
+
+    Device::Device(spi::SpiWriter& writer, BufferSizes transmitSizes, BufferSizes receiveSizes)
+        : spiWriter(writer), transmitBufferSizes(transmitSizes), receiveBufferSizes(receiveSizes)
+    {
+        writeModeRegister(Mode::reset);
+
+        for (std::uint8_t i = 0; i < supportedSockets; ++i)
+        {
+            const SocketHandle s{i};
+            write(registers::socketReceiveBufferSize(s), receiveBufferSizes[i]);
+            write(registers::socketTransmitBufferSize(s), transmitBufferSizes[i]);
+        }
+    }
+
+    void Device::executeSocketCommand(SocketHandle s, SocketCommand cmd)
+    {
+        const trace::Scope scope{trace::Probe::executeCommand};
+        write(registers::socketCommand(s), static_cast<std::uint8_t>(cmd));
+
+        while (static_cast<SocketCommand>(read(registers::socketCommand(s))) != SocketCommand::executed)
+        {
+            stats::countCommandWait();
+        }
+    }
+
+    void Device::writeSocketModeRegister(SocketHandle s, std::uint8_t value)
+    {
+        write(registers::socketMode(s), value);
+    }
+
+    void Device::writeSocketSourcePort(SocketHandle s, std::uint16_t value)
+    {
+        write(registers::socketSourcePort(s), value);
+    }
+
+    void Device::writeSocketInterruptRegister(SocketHandle s, SocketInterrupt value)
+    {
+        write(registers::socketInterrupt(s), value.value());
+    }
+
+    SocketInterrupt Device::readSocketInterruptRegister(SocketHandle s)
+    {
+        return static_cast<SocketInterrupt>(read(registers::socketInterrupt(s)));
+    }
+
+    std::uint8_t Device::readInterruptRegister()
+    {
+        return read(registers::socketInterrupts);
+    }
+
+    void Device::writeInterruptMaskRegister(std::uint8_t value)
+    {
+        write(registers::socketInterruptMask, value);
+    }
+
+    SocketStatus Device::readSocketStatusRegister(SocketHandle s)
+    {
+        return static_cast<SocketStatus>(read(registers::socketStatus(s)));
+    }
+
+    SocketSnapshot Device::readSocketState(SocketHandle s)
+    {
+        socketstate::Block block{};
+        readFrame(block::socketRegister(s), 0x0000, block);
+        return socketstate::decode(block);
+    }
+
+    std::uint16_t Device::getTransmitFreeSize(SocketHandle s)
+    {
+        return readFreesize(registers::socketTransmitFreeSize(s));
+    }
+
+    std::uint16_t Device::getReceiveFreeSize(SocketHandle s)
+    {
+        return readFreesize(registers::socketReceiveFreeSize(s));
+    }
+
+    std::uint16_t Device::readFreesize(Register<std::uint16_t> freesizeReg)
+    {
+        std::uint16_t firstRead{0};
+        std::uint16_t secondRead{0};
+
+        do
+        {
+            firstRead = read(freesizeReg);
+
+            if (firstRead != 0)
+            {
+                secondRead = read(freesizeReg);
+            }
+
+            if (secondRead != firstRead)
+            {
+                stats::countFreeSizeRetry();
+            }
+        } while (secondRead != firstRead);
+
+        return secondRead;
+    }
+
+    void Device::sendData(SocketHandle s, const std::span<const std::uint8_t> buffer)
+    {
+        const std::uint16_t writePointer = readTransmitPointer(s);
+        writeTransmitBuffer(s, writePointer, buffer);
+        writeTransmitPointer(s, static_cast<std::uint16_t>(writePointer + buffer.size()));
+    }
+
+    void Device::sendData(SocketHandle s, std::span<const std::span<const std::uint8_t>> segments)
+    {
+        const std::uint16_t writePointer = readTransmitPointer(s);
+        std::uint16_t pointer = writePointer;
+
+        for (const auto& segment : segments)
+        {
+            if (segment.empty() == false)
+            {
+                writeTransmitBuffer(s, pointer, segment);
+                pointer += segment.size();
+            }
+        }
+
+        writeTransmitPointer(s, pointer);
+    }
+
+    std::uint16_t Device::receiveData(SocketHandle s, std::span<std::uint8_t> buffer)
+    {
+        const std::uint16_t readPointer = readReceivePointer(s);
+        readReceiveBuffer(s, readPointer, buffer);
+        writeReceivePointer(s, static_cast<std::uint16_t>(readPointer + buffer.size()));
+
+        return buffer.size();
+    }
+
+    std::uint16_t Device::readTransmitPointer(SocketHandle s)
+    {
+        return read(registers::socketTransmitWritePointer(s));
+    }
+
+    void Device::writeTransmitPointer(SocketHandle s, std::uint16_t value)
+    {
+        write(registers::socketTransmitWritePointer(s), value);
+    }
+
+    std::uint16_t Device::readReceivePointer(SocketHandle s)
+    {
+        return read(registers::socketReceiveReadPointer(s));
+    }
+
+    void Device::writeReceivePointer(SocketHandle s, std::uint16_t value)
+    {
+        write(registers::socketReceiveReadPointer(s), value);
+    }
+
+    void Device::writeTransmitBuffer(SocketHandle s, std::uint16_t pointer, std::span<const std::uint8_t> buffer)
+    {
+        writeFrame(block::transmitBuffer(s), pointer, buffer);
+    }
+
+    void Device::readReceiveBuffer(SocketHandle s, std::uint16_t pointer, std::span<std::uint8_t> buffer)
+    {
+        readFrame(block::receiveBuffer(s), pointer, buffer);
+    }
+
+    void Device::writeModeRegister(Mode value)
+    {
+        write(registers::mode, static_cast<std::uint8_t>(value));
+    }
+
+    void Device::setDestAddress(SocketHandle s, NetAddress<4> addr, std::uint16_t port)
+    {
+        write(registers::socketDestIpAddress(s), addr);
+        write(registers::socketDestPort(s), port);
+    }
+
+    void Device::writeFrame(std::uint8_t block, std::uint16_t address, std::span<const std::uint8_t> data)
+    {
+        const auto header = makeHeader(block, address, Access::write);
+        spiWriter.writeFrame(header, data);
+    }
+
+    void Device::readFrame(std::uint8_t block, std::uint16_t address, std::span<std::uint8_t> data)
+    {
+        const auto header = makeHeader(block, address, Access::read);
+        spiWriter.readFrame(header, data);
+    }
+
+
+    void setupDevice(Device& dev, eth::NetConfig config)
+    {
+        const auto [ip, subnet, gateway, mac] = config;
+        dev.write(registers::sourceIpAddress, ip);
+        dev.write(registers::subnetMask, subnet);
+        dev.write(registers::gatewayAddress, gateway);
+        dev.write(registers::sourceMacAddress, mac);
+    }
+
+}
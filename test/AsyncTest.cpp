@@ -0,0 +1,259 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Socket.h"
+#include "async/Scheduler.h"
+#include "async/Task.h"
+#include "mock/NetDeviceMock.h"
+#include "TestHelper.h"
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::NetAddress;
+using eth::Socket;
+using eth::SocketCommand;
+using eth::SocketHandle;
+using eth::SocketStatus;
+using eth::async::Scheduler;
+using eth::async::Task;
+using eth::test::NetDeviceMock;
+
+
+namespace
+{
+    inline constexpr SocketHandle socketHandle = eth::makeHandle<0>();
+
+
+    Task acceptOnce(Socket& socket, Scheduler& scheduler, Socket::Status& result)
+    {
+        result = co_await socket.asyncAccept(scheduler);
+    }
+
+    Task receiveOnce(Socket& socket, Scheduler& scheduler, std::span<std::uint8_t> buffer, Socket::Result& result)
+    {
+        result = co_await socket.asyncReceive(scheduler, buffer);
+    }
+
+    Task sendOnce(Socket& socket, Scheduler& scheduler, std::span<const std::uint8_t> buffer, Socket::Result& result)
+    {
+        result = co_await socket.asyncSend(scheduler, buffer);
+    }
+
+    Task connectOnce(Socket& socket, Scheduler& scheduler, NetAddress<4> address, Socket::Status& result)
+    {
+        result = co_await socket.asyncConnect(scheduler, address, 4567);
+    }
+
+    bool alwaysReady([[maybe_unused]] void* awaiter)
+    {
+        return true;
+    }
+}
+
+
+TEST_GROUP(AsyncTest)
+{
+    void setup() override
+    {
+        socket = std::make_unique<Socket>(socketHandle, device);
+        mock().strictOrder();
+    }
+
+    void teardown() override
+    {
+        mock().disable();
+        socket.reset();
+        mock().enable();
+        mock().checkExpectations();
+        mock().clear();
+    }
+
+    void expectStatus(SocketStatus status) const
+    {
+        mock("Device")
+            .expectOneCall("readSocketStatusRegister")
+            .withParameter("socket", socketHandle.value())
+            .andReturnValue(static_cast<std::uint8_t>(status));
+    }
+
+    void expectFreeSize(const char* name, std::uint16_t value) const
+    {
+        mock("Device").expectOneCall(name).withParameter("socket", socketHandle.value()).andReturnValue(value);
+    }
+
+
+    NetDeviceMock device;
+    std::unique_ptr<Socket> socket;
+    Scheduler scheduler;
+};
+
+TEST(AsyncTest, completedOperationDoesNotSuspend)
+{
+    expectStatus(SocketStatus::established);
+
+    Socket::Status result{Socket::Status::failed};
+    const auto task = acceptOnce(*socket, scheduler, result);
+    CHECK_TRUE(task.isStarted());
+    CHECK_EQUAL(Socket::Status::ok, result);
+    CHECK_EQUAL(0, scheduler.pending());
+    CHECK_EQUAL(0, eth::async::framesInUse());
+}
+
+TEST(AsyncTest, acceptResumesOnConnection)
+{
+    expectStatus(SocketStatus::listen);
+    expectStatus(SocketStatus::listen);
+    expectStatus(SocketStatus::established);
+
+    Socket::Status result{Socket::Status::failed};
+    acceptOnce(*socket, scheduler, result);
+    CHECK_EQUAL(1, scheduler.pending());
+    CHECK_EQUAL(0, scheduler.poll());
+    CHECK_EQUAL(1, scheduler.poll());
+    CHECK_EQUAL(Socket::Status::ok, result);
+    CHECK_EQUAL(0, scheduler.pending());
+    CHECK_EQUAL(0, eth::async::framesInUse());
+}
+
+TEST(AsyncTest, receiveResumesWithData)
+{
+    constexpr std::uint16_t size{4};
+    expectStatus(SocketStatus::established);
+    expectFreeSize("getReceiveFreeSize", 0);
+    expectStatus(SocketStatus::established);
+    expectFreeSize("getReceiveFreeSize", size);
+    mock("Device").expectOneCall("receiveData").withParameter("size", size).ignoreOtherParameters().andReturnValue(size);
+    mock("Device")
+        .expectOneCall("executeSocketCommand")
+        .withParameter("socket", socketHandle.value())
+        .withParameter("value", static_cast<std::uint8_t>(SocketCommand::receive));
+
+    std::array<std::uint8_t, 10> buffer{};
+    Socket::Result result{Socket::Status::failed, 0};
+    receiveOnce(*socket, scheduler, buffer, result);
+    CHECK_EQUAL(Socket::Status::failed, result.status);
+    CHECK_EQUAL(1, scheduler.poll());
+    CHECK_EQUAL(Socket::Status::ok, result.status);
+    CHECK_EQUAL(size, result.size);
+}
+
+TEST(AsyncTest, sendResumesWithFreeMemory)
+{
+    constexpr std::uint16_t size{6};
+    expectStatus(SocketStatus::established);
+    expectFreeSize("getTransmitFreeSize", 0);
+    expectStatus(SocketStatus::established);
+    expectFreeSize("getTransmitFreeSize", 100);
+    mock("Device").expectOneCall("sendData").withParameter("size", size).ignoreOtherParameters();
+    mock("Device").expectOneCall("executeSocketCommand").ignoreOtherParameters();
+
+    const auto buffer = createBuffer(size);
+    Socket::Result result{Socket::Status::failed, 0};
+    sendOnce(*socket, scheduler, buffer, result);
+    CHECK_EQUAL(1, scheduler.poll());
+    CHECK_EQUAL(Socket::Status::ok, result.status);
+    CHECK_EQUAL(size, result.size);
+}
+
+TEST(AsyncTest, connectStartsOnceAndResumesWhenEstablished)
+{
+    const NetAddress<4> addr{{127, 0, 0, 1}};
+    mock("Device").expectOneCall("setDestAddress").ignoreOtherParameters();
+    mock("Device").expectOneCall("executeSocketCommand").ignoreOtherParameters();
+    expectStatus(SocketStatus::synSent);
+    mock("Device")
+        .expectOneCall("readSocketInterruptRegister")
+        .withParameter("socket", socketHandle.value())
+        .andReturnValue(0);
+    expectStatus(SocketStatus::established);
+
+    Socket::Status result{Socket::Status::failed};
+    connectOnce(*socket, scheduler, addr, result);
+    CHECK_EQUAL(1, scheduler.poll());
+    CHECK_EQUAL(Socket::Status::ok, result);
+}
+
+TEST(AsyncTest, taskFailsIfFramePoolExhausted)
+{
+    std::array<Socket::Status, eth::async::maxFrames> results{};
+
+    mock("Device")
+        .expectNCalls(eth::async::maxFrames, "readSocketStatusRegister")
+        .ignoreOtherParameters()
+        .andReturnValue(static_cast<std::uint8_t>(SocketStatus::listen));
+
+    for (auto& result : results)
+    {
+        CHECK_TRUE(acceptOnce(*socket, scheduler, result).isStarted());
+    }
+
+    Socket::Status result{Socket::Status::failed};
+    CHECK_FALSE(acceptOnce(*socket, scheduler, result).isStarted());
+    CHECK_EQUAL(eth::async::maxFrames, eth::async::framesInUse());
+
+    mock("Device")
+        .expectNCalls(eth::async::maxFrames, "readSocketStatusRegister")
+        .ignoreOtherParameters()
+        .andReturnValue(static_cast<std::uint8_t>(SocketStatus::established));
+    CHECK_EQUAL(eth::async::maxFrames, scheduler.poll());
+    CHECK_EQUAL(0, eth::async::framesInUse());
+}
+
+TEST(AsyncTest, everySuspendedTaskGetsWaiterSlot)
+{
+    std::array<Socket::Status, eth::async::maxFrames> results{};
+    results.fill(Socket::Status::failed);
+
+    mock("Device")
+        .expectNCalls(eth::async::maxFrames, "readSocketStatusRegister")
+        .ignoreOtherParameters()
+        .andReturnValue(static_cast<std::uint8_t>(SocketStatus::listen));
+
+    for (auto& result : results)
+    {
+        acceptOnce(*socket, scheduler, result);
+    }
+
+    CHECK_EQUAL(eth::async::maxFrames, scheduler.pending());
+    CHECK_TRUE(std::ranges::all_of(results, [](auto result) { return result == Socket::Status::failed; }));
+
+    mock("Device")
+        .expectNCalls(eth::async::maxFrames, "readSocketStatusRegister")
+        .ignoreOtherParameters()
+        .andReturnValue(static_cast<std::uint8_t>(SocketStatus::established));
+    CHECK_EQUAL(eth::async::maxFrames, scheduler.poll());
+    CHECK_TRUE(std::ranges::all_of(results, [](auto result) { return result == Socket::Status::ok; }));
+}
+
+TEST(AsyncTest, schedulerRejectsWaitersIfFull)
+{
+    for (std::size_t i = 0; i < Scheduler::maxWaiters; ++i)
+    {
+        CHECK_TRUE(scheduler.wait(std::noop_coroutine(), alwaysReady, nullptr));
+    }
+
+    CHECK_FALSE(scheduler.wait(std::noop_coroutine(), alwaysReady, nullptr));
+    CHECK_EQUAL(Scheduler::maxWaiters, scheduler.pending());
+    CHECK_EQUAL(Scheduler::maxWaiters, scheduler.poll());
+    CHECK_EQUAL(0, scheduler.pending());
+}
@@ -0,0 +1,169 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "http/Request.h"
+#include "TestHelper.h"
+#include <array>
+#include <string>
+#include <string_view>
+#include <CppUTest/TestHarness.h>
+
+using eth::http::Method;
+using eth::http::RequestParser;
+
+
+SimpleString StringFrom(Method method)
+{
+    return StringFrom(static_cast<unsigned int>(method));
+}
+
+SimpleString StringFrom(RequestParser::Result result)
+{
+    return StringFrom(static_cast<unsigned int>(result));
+}
+
+
+namespace
+{
+    std::span<const std::uint8_t> asBytes(std::string_view text)
+    {
+        return {reinterpret_cast<const std::uint8_t*>(text.data()), text.size()};
+    }
+}
+
+
+TEST_GROUP(HttpRequestTest)
+{
+    RequestParser::Result parse(std::string_view text)
+    {
+        parser.parse(asBytes(text));
+        return parser.result();
+    }
+
+    RequestParser parser;
+};
+
+TEST(HttpRequestTest, parsesRequestLine)
+{
+    CHECK_EQUAL(RequestParser::Result::complete, parse("GET /status HTTP/1.1\r\n\r\n"));
+
+    const auto request = parser.request();
+    CHECK_EQUAL(Method::get, request.method);
+    STRCMP_EQUAL("/status", std::string{request.path}.c_str());
+    CHECK_TRUE(request.keepAlive);
+    CHECK_EQUAL(0, request.contentLength);
+}
+
+TEST(HttpRequestTest, parsesMethods)
+{
+    constexpr std::array<std::pair<std::string_view, Method>, 6> methods{{{"GET", Method::get},
+                                                                          {"HEAD", Method::head},
+                                                                          {"POST", Method::post},
+                                                                          {"PUT", Method::put},
+                                                                          {"DELETE", Method::del},
+                                                                          {"PATCH", Method::unknown}}};
+
+    for (const auto& [name, method] : methods)
+    {
+        parser.reset();
+        parse(name);
+        CHECK_EQUAL(RequestParser::Result::complete, parse(" / HTTP/1.1\r\n\r\n"));
+        CHECK_EQUAL(method, parser.request().method);
+    }
+}
+
+TEST(HttpRequestTest, parsesIncrementally)
+{
+    constexpr std::string_view text{"POST /config HTTP/1.1\r\nContent-Length: 12\r\n\r\n"};
+
+    for (const auto c : text.substr(0, text.size() - 1))
+    {
+        CHECK_EQUAL(1, parser.parse(asBytes({&c, 1})));
+        CHECK_EQUAL(RequestParser::Result::incomplete, parser.result());
+    }
+
+    CHECK_EQUAL(RequestParser::Result::complete, parse(text.substr(text.size() - 1)));
+    CHECK_EQUAL(12, parser.request().contentLength);
+}
+
+TEST(HttpRequestTest, stopsAtEndOfHeader)
+{
+    constexpr std::string_view text{"GET / HTTP/1.1\r\n\r\nGET /next HTTP/1.1\r\n\r\n"};
+
+    CHECK_EQUAL(18, parser.parse(asBytes(text)));
+    CHECK_EQUAL(RequestParser::Result::complete, parser.result());
+}
+
+TEST(HttpRequestTest, headersAreCaseInsensitive)
+{
+    CHECK_EQUAL(RequestParser::Result::complete, parse("PUT /x HTTP/1.1\r\ncontent-LENGTH:7\r\nCONNECTION:  Close \r\n\r\n"));
+    CHECK_EQUAL(7, parser.request().contentLength);
+    CHECK_FALSE(parser.request().keepAlive);
+}
+
+TEST(HttpRequestTest, http10ClosesByDefault)
+{
+    CHECK_EQUAL(RequestParser::Result::complete, parse("GET / HTTP/1.0\r\n\r\n"));
+    CHECK_FALSE(parser.request().keepAlive);
+
+    parser.reset();
+    CHECK_EQUAL(RequestParser::Result::complete, parse("GET / HTTP/1.0\r\nConnection: keep-alive\r\n\r\n"));
+    CHECK_TRUE(parser.request().keepAlive);
+}
+
+TEST(HttpRequestTest, ignoresUnknownHeaders)
+{
+    CHECK_EQUAL(RequestParser::Result::complete,
+                parse("GET / HTTP/1.1\r\nHost: 192.168.1.8\r\nUser-Agent: a-very-long-user-agent-value/1.0\r\n\r\n"));
+}
+
+TEST(HttpRequestTest, rejectsMalformedRequests)
+{
+    CHECK_EQUAL(RequestParser::Result::badRequest, parse("GET  HTTP/1.1\r\n\r\n"));
+    parser.reset();
+    CHECK_EQUAL(RequestParser::Result::badRequest, parse("GET / HTTP/2.0\r\n\r\n"));
+    parser.reset();
+    CHECK_EQUAL(RequestParser::Result::badRequest, parse("GET /\r\n\r\n"));
+    parser.reset();
+    CHECK_EQUAL(RequestParser::Result::badRequest, parse("GET / HTTP/1.1\r\nContent-Length: 1x\r\n\r\n"));
+    parser.reset();
+    CHECK_EQUAL(RequestParser::Result::badRequest, parse("GET / HTTP/1.1\r\nbroken\r\n\r\n"));
+}
+
+TEST(HttpRequestTest, rejectsTransferEncodingWithoutLength)
+{
+    CHECK_EQUAL(RequestParser::Result::lengthRequired,
+                parse("POST /config HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"));
+}
+
+TEST(HttpRequestTest, rejectsTransferEncodingWithLength)
+{
+    CHECK_EQUAL(RequestParser::Result::notImplemented,
+                parse("POST /config HTTP/1.1\r\nContent-Length: 4\r\nTransfer-Encoding: chunked\r\n\r\n"));
+    parser.reset();
+    CHECK_EQUAL(RequestParser::Result::notImplemented,
+                parse("POST /config HTTP/1.1\r\nTransfer-Encoding: gzip, chunked\r\nContent-Length: 4\r\n\r\n"));
+}
+
+TEST(HttpRequestTest, rejectsTooLongPath)
+{
+    const std::string path(RequestParser::maxPathSize + 1, 'a');
+    CHECK_EQUAL(RequestParser::Result::uriTooLong, parse("GET /" + path));
+}
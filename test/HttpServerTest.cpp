@@ -0,0 +1,318 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "http/Server.h"
+#include "sim/W5100Simulator.h"
+#include "w5100/Device.h"
+#include "TestHelper.h"
+#include <array>
+#include <string>
+#include <string_view>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::SocketStatus;
+using eth::http::Method;
+using eth::http::Request;
+using eth::http::Response;
+using eth::http::Route;
+using eth::http::StatusCode;
+using eth::sim::W5100Simulator;
+
+
+namespace
+{
+    constexpr std::uint16_t port{80};
+    constexpr auto client = eth::makeHandle<0>();
+    constexpr auto otherClient = eth::makeHandle<1>();
+
+    std::string lastBody;
+
+    void statusHandler([[maybe_unused]] Request& request, Response& response)
+    {
+        response.send(StatusCode::ok, "text/plain", "up");
+    }
+
+    void streamHandler([[maybe_unused]] Request& request, Response& response)
+    {
+        response.begin(StatusCode::ok, "text/html");
+        response.write("<p>");
+        response.write("ok</p>");
+    }
+
+    void configHandler(Request& request, Response& response)
+    {
+        std::array<std::uint8_t, 4> buffer{};
+        const auto size = request.readBody(buffer);
+        lastBody.assign(buffer.begin(), std::next(buffer.begin(), size));
+        response.send(StatusCode::ok, "text/plain", "stored");
+    }
+
+    void largeHandler([[maybe_unused]] Request& request, Response& response)
+    {
+        static const std::string body(2500, 'x');
+        response.send(StatusCode::ok, "text/plain", body);
+    }
+
+    void emptyHandler([[maybe_unused]] Request& request, [[maybe_unused]] Response& response)
+    {
+    }
+
+    constexpr std::array<Route, 5> routes{{{Method::get, "/status", &statusHandler},
+                                           {Method::get, "/page", &streamHandler},
+                                           {Method::post, "/config", &configHandler},
+                                           {Method::del, "/config", &emptyHandler},
+                                           {Method::get, "/large", &largeHandler}}};
+
+    static_assert(eth::http::hasUniqueRoutes(routes));
+    static_assert(eth::http::findRoute(routes, "/config", Method::post) == &routes[2]);
+    static_assert(eth::http::findRoute(routes, "/config", Method::get) == nullptr);
+}
+
+
+TEST_GROUP(HttpServerTest)
+{
+    void setup() override
+    {
+        mock("platform").ignoreOtherCalls();
+        lastBody.clear();
+        server.listen();
+        simulator.acceptConnection(client);
+    }
+
+    void teardown() override
+    {
+        mock().clear();
+    }
+
+    void request(std::string_view text, eth::SocketHandle s = client)
+    {
+        simulator.injectReceive(s, {reinterpret_cast<const std::uint8_t*>(text.data()), text.size()});
+    }
+
+    std::string response(eth::SocketHandle s = client)
+    {
+        const auto data = simulator.takeTransmitted(s);
+        return {data.cbegin(), data.cend()};
+    }
+
+
+    W5100Simulator simulator;
+    eth::w5100::BasicDevice<W5100Simulator> device{simulator};
+    eth::http::Server server{device, port, routes, 2};
+};
+
+TEST(HttpServerTest, noRequestKeepsConnection)
+{
+    CHECK_EQUAL(1, server.poll());
+    STRCMP_EQUAL("", response().c_str());
+}
+
+TEST(HttpServerTest, respondsWithContentLength)
+{
+    request("GET /status HTTP/1.1\r\nHost: device\r\n\r\n");
+    CHECK_EQUAL(1, server.poll());
+
+    STRCMP_EQUAL("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 2\r\n"
+                 "Connection: keep-alive\r\n\r\nup",
+                 response().c_str());
+}
+
+TEST(HttpServerTest, respondsChunked)
+{
+    request("GET /page HTTP/1.1\r\n\r\n");
+    server.poll();
+
+    STRCMP_EQUAL("HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nTransfer-Encoding: chunked\r\n"
+                 "Connection: keep-alive\r\n\r\n3\r\n<p>\r\n6\r\nok</p>\r\n0\r\n\r\n",
+                 response().c_str());
+}
+
+TEST(HttpServerTest, keepAliveServesSeveralRequests)
+{
+    request("GET /status HTTP/1.1\r\n\r\nGET /status HTTP/1.1\r\n\r\n");
+    server.poll();
+    server.poll();
+
+    const auto text = response();
+    CHECK_EQUAL(2, std::count(text.cbegin(), text.cend(), 'u'));
+    CHECK_EQUAL(SocketStatus::established, simulator.status(client));
+}
+
+TEST(HttpServerTest, partialRequestWaitsForRemainder)
+{
+    request("GET /sta");
+    server.poll();
+    STRCMP_EQUAL("", response().c_str());
+
+    request("tus HTTP/1.1\r\n\r\n");
+    server.poll();
+    CHECK_TRUE(response().starts_with("HTTP/1.1 200 OK\r\n"));
+}
+
+TEST(HttpServerTest, handlerReadsBody)
+{
+    request("POST /config HTTP/1.1\r\nContent-Length: 4\r\n\r\nab=1");
+    server.poll();
+
+    STRCMP_EQUAL("ab=1", lastBody.c_str());
+    CHECK_TRUE(response().ends_with("stored"));
+}
+
+TEST(HttpServerTest, unreadBodyIsDiscarded)
+{
+    request("POST /config HTTP/1.1\r\nContent-Length: 8\r\n\r\nab=1cd=2GET /status HTTP/1.1\r\n\r\n");
+    server.poll();
+    response();
+    server.poll();
+
+    CHECK_TRUE(response().ends_with("up"));
+}
+
+TEST(HttpServerTest, emptyHandlerRespondsNoContent)
+{
+    request("DELETE /config HTTP/1.1\r\n\r\n");
+    server.poll();
+
+    STRCMP_EQUAL("HTTP/1.1 204 No Content\r\nConnection: keep-alive\r\n\r\n", response().c_str());
+}
+
+TEST(HttpServerTest, headRequestSendsHeadersOnly)
+{
+    request("HEAD /status HTTP/1.1\r\n\r\n");
+    server.poll();
+
+    STRCMP_EQUAL("HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 2\r\n"
+                 "Connection: keep-alive\r\n\r\n",
+                 response().c_str());
+}
+
+TEST(HttpServerTest, headRequestOmitsChunkedBody)
+{
+    request("HEAD /page HTTP/1.1\r\n\r\n");
+    server.poll();
+
+    STRCMP_EQUAL("HTTP/1.1 200 OK\r\nContent-Type: text/html\r\nTransfer-Encoding: chunked\r\n"
+                 "Connection: keep-alive\r\n\r\n",
+                 response().c_str());
+}
+
+TEST(HttpServerTest, unknownPathIsNotFound)
+{
+    request("GET /missing HTTP/1.1\r\n\r\n");
+    server.poll();
+
+    CHECK_TRUE(response().starts_with("HTTP/1.1 404 Not Found\r\n"));
+}
+
+TEST(HttpServerTest, wrongMethodIsNotAllowed)
+{
+    request("PUT /status HTTP/1.1\r\n\r\n");
+    server.poll();
+
+    CHECK_TRUE(response().starts_with("HTTP/1.1 405 Method Not Allowed\r\n"));
+}
+
+TEST(HttpServerTest, connectionCloseRearmsSocket)
+{
+    request("GET /status HTTP/1.1\r\nConnection: close\r\n\r\n");
+
+    CHECK_EQUAL(0, server.poll());
+    CHECK_TRUE(response().find("Connection: close\r\n") != std::string::npos);
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(client));
+}
+
+TEST(HttpServerTest, malformedRequestIsRejected)
+{
+    request("GET / HTTP/3\r\n\r\n");
+
+    CHECK_EQUAL(0, server.poll());
+    CHECK_TRUE(response().starts_with("HTTP/1.1 400 Bad Request\r\n"));
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(client));
+}
+
+TEST(HttpServerTest, chunkedRequestIsRejected)
+{
+    request("POST /config HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n4\r\nab=1\r\n0\r\n\r\n");
+
+    CHECK_EQUAL(0, server.poll());
+    CHECK_TRUE(response().starts_with("HTTP/1.1 411 Length Required\r\n"));
+    STRCMP_EQUAL("", lastBody.c_str());
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(client));
+}
+
+TEST(HttpServerTest, transferEncodingWithLengthIsNotImplemented)
+{
+    request("POST /config HTTP/1.1\r\nContent-Length: 27\r\nTransfer-Encoding: chunked\r\n\r\n"
+            "0\r\n\r\nGET /status HTTP/1.1\r\n\r\n");
+
+    CHECK_EQUAL(0, server.poll());
+    const auto text = response();
+    CHECK_TRUE(text.starts_with("HTTP/1.1 501 Not Implemented\r\n"));
+    CHECK_TRUE(text.find("200 OK") == std::string::npos);
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(client));
+}
+
+TEST(HttpServerTest, peerCloseReleasesConnection)
+{
+    server.poll();
+    simulator.closeByPeer(client);
+
+    CHECK_EQUAL(0, server.poll());
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(client));
+}
+
+TEST(HttpServerTest, stalledPeerDoesNotBlockOtherClients)
+{
+    simulator.stallPeer(client);
+    request("GET /large HTTP/1.1\r\n\r\n");
+    server.poll();
+
+    simulator.acceptConnection(otherClient);
+    request("GET /status HTTP/1.1\r\n\r\n", otherClient);
+    CHECK_EQUAL(2, server.poll());
+    CHECK_TRUE(response(otherClient).ends_with("up"));
+    STRCMP_EQUAL("", response().c_str());
+
+    simulator.resumePeer(client);
+    server.poll();
+    simulator.resumePeer(client);
+
+    const auto text = response();
+    CHECK_TRUE(text.starts_with("HTTP/1.1 200 OK\r\n"));
+    CHECK_TRUE(text.ends_with(std::string(2500, 'x')));
+}
+
+TEST(HttpServerTest, pendingCloseDoesNotBlockOtherClients)
+{
+    simulator.stallPeer(client);
+    request("GET /status HTTP/1.1\r\nConnection: close\r\n\r\n");
+    simulator.acceptConnection(otherClient);
+    request("GET /status HTTP/1.1\r\n\r\n", otherClient);
+
+    CHECK_EQUAL(2, server.poll());
+    CHECK_EQUAL(SocketStatus::finWait, simulator.status(client));
+    CHECK_TRUE(response(otherClient).ends_with("up"));
+
+    simulator.resumePeer(client);
+    CHECK_EQUAL(1, server.poll());
+    CHECK_TRUE(response().ends_with("up"));
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(client));
+}
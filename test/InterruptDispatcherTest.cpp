@@ -0,0 +1,190 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "InterruptDispatcher.h"
+#include "mock/NetDeviceMock.h"
+#include <vector>
+#include <memory>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::InterruptDispatcher;
+using eth::SocketHandle;
+using eth::SocketInterrupt;
+using eth::test::NetDeviceMock;
+
+
+namespace
+{
+    inline constexpr SocketHandle socketHandle = eth::makeHandle<0>();
+
+
+    struct Event
+    {
+        std::uint8_t socket;
+        InterruptDispatcher::Event event;
+    };
+
+    void recordEvent(SocketHandle s, InterruptDispatcher::Event event, void* context)
+    {
+        static_cast<std::vector<Event>*>(context)->push_back({s.value(), event});
+    }
+}
+
+
+TEST_GROUP(InterruptDispatcherTest)
+{
+    void setup() override
+    {
+        dispatcher = std::make_unique<InterruptDispatcher>(device);
+        mock().strictOrder();
+    }
+
+    void teardown() override
+    {
+        mock().checkExpectations();
+        mock().clear();
+    }
+
+    void expectInterruptMask(std::uint8_t value) const
+    {
+        mock("Device").expectOneCall("writeInterruptMaskRegister").withParameter("value", value);
+    }
+
+    void expectInterruptRead(std::uint8_t value) const
+    {
+        mock("Device").expectOneCall("readInterruptRegister").andReturnValue(value);
+    }
+
+    void expectSocketInterrupt(SocketHandle s, std::uint8_t value) const
+    {
+        mock("Device").expectOneCall("readSocketInterruptRegister").withParameter("socket", s.value()).andReturnValue(value);
+        mock("Device")
+            .expectOneCall("writeSocketInterruptRegister")
+            .withParameter("socket", s.value())
+            .withParameter("value", value);
+    }
+
+    void registerRecorder(SocketHandle s, std::uint8_t mask)
+    {
+        expectInterruptMask(mask);
+        dispatcher->registerHandler(s, recordEvent, &events);
+    }
+
+
+    NetDeviceMock device;
+    std::unique_ptr<InterruptDispatcher> dispatcher;
+    std::vector<Event> events;
+};
+
+TEST(InterruptDispatcherTest, registerHandlerEnablesSocketInterrupt)
+{
+    registerRecorder(socketHandle, 0x01);
+    registerRecorder(eth::makeHandle<2>(), 0x05);
+}
+
+TEST(InterruptDispatcherTest, unregisterHandlerDisablesSocketInterrupt)
+{
+    registerRecorder(socketHandle, 0x01);
+    registerRecorder(eth::makeHandle<3>(), 0x09);
+    expectInterruptMask(0x08);
+
+    dispatcher->unregisterHandler(socketHandle);
+}
+
+TEST(InterruptDispatcherTest, processWithoutNotificationDoesNothing)
+{
+    CHECK_FALSE(dispatcher->isPending());
+    CHECK_EQUAL(0, dispatcher->process());
+}
+
+TEST(InterruptDispatcherTest, notifySetsPending)
+{
+    dispatcher->notify();
+    CHECK_TRUE(dispatcher->isPending());
+}
+
+TEST(InterruptDispatcherTest, processDispatchesSocketEvents)
+{
+    registerRecorder(socketHandle, 0x01);
+    expectInterruptRead(0x01);
+    expectSocketInterrupt(socketHandle, 0b00000101);
+    expectInterruptRead(0x00);
+
+    dispatcher->notify();
+    CHECK_EQUAL(2, dispatcher->process());
+    CHECK_FALSE(dispatcher->isPending());
+    CHECK_EQUAL(2, events.size());
+    CHECK_EQUAL(0, events[0].socket);
+    CHECK_TRUE(events[0].event == SocketInterrupt::Mask::connect);
+    CHECK_TRUE(events[1].event == SocketInterrupt::Mask::receive);
+}
+
+TEST(InterruptDispatcherTest, processDispatchesMultipleSockets)
+{
+    constexpr auto handle = eth::makeHandle<3>();
+    registerRecorder(socketHandle, 0x01);
+    registerRecorder(handle, 0x09);
+    expectInterruptRead(0x09);
+    expectSocketInterrupt(socketHandle, 0b00010000);
+    expectSocketInterrupt(handle, 0b00000010);
+    expectInterruptRead(0x00);
+
+    dispatcher->notify();
+    CHECK_EQUAL(2, dispatcher->process());
+    CHECK_EQUAL(2, events.size());
+    CHECK_TRUE(events[0].event == SocketInterrupt::Mask::send);
+    CHECK_EQUAL(3, events[1].socket);
+    CHECK_TRUE(events[1].event == SocketInterrupt::Mask::disconnect);
+}
+
+TEST(InterruptDispatcherTest, processRepeatsUntilInterruptsCleared)
+{
+    registerRecorder(socketHandle, 0x01);
+    expectInterruptRead(0x01);
+    expectSocketInterrupt(socketHandle, 0b00000001);
+    expectInterruptRead(0x01);
+    expectSocketInterrupt(socketHandle, 0b00001000);
+    expectInterruptRead(0x00);
+
+    dispatcher->notify();
+    CHECK_EQUAL(2, dispatcher->process());
+    CHECK_TRUE(events[1].event == SocketInterrupt::Mask::timeout);
+}
+
+TEST(InterruptDispatcherTest, processLeavesInterruptWithoutHandler)
+{
+    expectInterruptRead(0x02);
+
+    dispatcher->notify();
+    CHECK_EQUAL(0, dispatcher->process());
+}
+
+TEST(InterruptDispatcherTest, processOnlyServicesSocketsWithHandler)
+{
+    registerRecorder(socketHandle, 0x01);
+    expectInterruptRead(0x03);
+    expectSocketInterrupt(socketHandle, 0b00000100);
+    expectInterruptRead(0x02);
+
+    dispatcher->notify();
+    CHECK_EQUAL(1, dispatcher->process());
+    CHECK_EQUAL(1, events.size());
+}
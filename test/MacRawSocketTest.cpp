@@ -0,0 +1,187 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MacRawSocket.h"
+#include "SocketStatus.h"
+#include "SocketCommand.h"
+#include "Protocol.h"
+#include "mock/NetDeviceMock.h"
+#include "TestHelper.h"
+#include <array>
+#include <memory>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::MacRawSocket;
+using eth::Protocol;
+using eth::SocketCommand;
+using eth::SocketStatus;
+using eth::test::NetDeviceMock;
+
+
+TEST_GROUP(MacRawSocketTest)
+{
+    void setup() override
+    {
+        socket = std::make_unique<MacRawSocket>(device);
+        mock().strictOrder();
+    }
+
+    void teardown() override
+    {
+        mock().disable();
+        socket.reset();
+        mock().enable();
+        mock().checkExpectations();
+        mock().clear();
+    }
+
+    void expectSocketCommand(SocketCommand cmd) const
+    {
+        mock("Device").expectOneCall("executeSocketCommand").withParameter("socket", 0).withParameter("value", static_cast<std::uint8_t>(cmd));
+    }
+
+    void expectSocketStatusRead(SocketStatus status) const
+    {
+        mock("Device").expectOneCall("readSocketStatusRegister").withParameter("socket", 0).andReturnValue(static_cast<std::uint8_t>(status));
+    }
+
+    void expectReceiveSize(std::uint16_t size) const
+    {
+        mock("Device").expectOneCall("getReceiveFreeSize").withParameter("socket", 0).andReturnValue(size);
+    }
+
+    template <class Container>
+    void expectReadBuffer(std::uint16_t pointer, const Container& data) const
+    {
+        mock("Device")
+            .expectOneCall("readReceiveBuffer")
+            .withParameter("socket", 0)
+            .withParameter("pointer", pointer)
+            .withOutputParameterReturning("buffer", data.data(), data.size())
+            .withParameter("size", data.size());
+    }
+
+    void expectReceiveDone(std::uint16_t pointer) const
+    {
+        mock("Device").expectOneCall("writeReceivePointer").withParameter("socket", 0).withParameter("value", pointer);
+        expectSocketCommand(SocketCommand::receive);
+    }
+
+
+    NetDeviceMock device;
+    std::unique_ptr<MacRawSocket> socket;
+};
+
+TEST(MacRawSocketTest, openOpensSocketZeroInMacRawMode)
+{
+    constexpr std::uint8_t macFilter{0x40};
+    expectSocketCommand(SocketCommand::close);
+    mock("Device").expectOneCall("writeSocketInterruptRegister").withParameter("socket", 0).withParameter("value", 0xff);
+    expectSocketStatusRead(SocketStatus::closed);
+    mock("Device")
+        .expectOneCall("writeSocketModeRegister")
+        .withParameter("socket", 0)
+        .withParameter("value", static_cast<std::uint8_t>(Protocol::macRaw) | macFilter);
+    expectSocketCommand(SocketCommand::open);
+    expectSocketStatusRead(SocketStatus::macRaw);
+
+    CHECK_EQUAL(MacRawSocket::Status::ok, socket->open(macFilter));
+}
+
+TEST(MacRawSocketTest, sendFrameSendsAndWaitsForCompletion)
+{
+    const auto frame = createBuffer(60);
+    mock("Device").expectOneCall("getTransmitFreeSize").withParameter("socket", 0).andReturnValue(2048);
+    mock("Device").expectOneCall("sendData").withParameter("socket", 0).withParameter("size", frame.size()).ignoreOtherParameters();
+    expectSocketCommand(SocketCommand::send);
+    mock("Device").expectOneCall("readSocketInterruptRegister").withParameter("socket", 0).andReturnValue(0x00);
+    mock("Device").expectOneCall("readSocketInterruptRegister").withParameter("socket", 0).andReturnValue(0x10);
+    mock("Device").expectOneCall("writeSocketInterruptRegister").withParameter("socket", 0).withParameter("value", 0x10);
+
+    CHECK_EQUAL(frame.size(), socket->sendFrame(frame));
+}
+
+TEST(MacRawSocketTest, receiveFrameWouldBlockWithoutData)
+{
+    expectReceiveSize(0);
+
+    std::array<std::uint8_t, 64> buffer{};
+    CHECK_EQUAL(MacRawSocket::Status::wouldBlock, socket->receiveFrame(buffer).status);
+}
+
+TEST(MacRawSocketTest, receiveFrameStripsLengthHeader)
+{
+    const auto frame = createBuffer(6);
+    expectReceiveSize(8);
+    mock("Device").expectOneCall("readReceivePointer").withParameter("socket", 0).andReturnValue(0x0200);
+    expectReadBuffer(0x0200, std::array<std::uint8_t, 2>{{0x00, 0x08}});
+    expectReadBuffer(0x0202, frame);
+    expectReceiveDone(0x0208);
+
+    std::array<std::uint8_t, 64> buffer{};
+    const auto result = socket->receiveFrame(buffer);
+    CHECK_EQUAL(MacRawSocket::Status::ok, result.status);
+    CHECK_EQUAL(6, result.size);
+    CHECK_TRUE(std::equal(frame.begin(), frame.end(), buffer.begin()));
+}
+
+TEST(MacRawSocketTest, receiveFramesDrainsFramesWithSingleRead)
+{
+    const std::array<std::uint8_t, 12> ring{{0x00, 0x05, 0xa1, 0xa2, 0xa3, 0x00, 0x07, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5}};
+    expectReceiveSize(ring.size());
+    mock("Device").expectOneCall("readReceivePointer").withParameter("socket", 0).andReturnValue(0x0010);
+    expectReadBuffer(0x0010, ring);
+    expectReceiveDone(0x001c);
+
+    std::array<std::uint8_t, 64> buffer{};
+    std::array<std::span<std::uint8_t>, 4> frames{};
+    CHECK_EQUAL(2, socket->receiveFrames(buffer, frames));
+    CHECK_EQUAL(3, frames[0].size());
+    CHECK_EQUAL(0xa1, frames[0][0]);
+    CHECK_EQUAL(5, frames[1].size());
+    CHECK_EQUAL(0xb5, frames[1][4]);
+}
+
+TEST(MacRawSocketTest, receiveFramesKeepsPartialFrameQueued)
+{
+    const std::array<std::uint8_t, 8> ring{{0x00, 0x04, 0xa1, 0xa2, 0x00, 0x08, 0xb1, 0xb2}};
+    expectReceiveSize(12);
+    mock("Device").expectOneCall("readReceivePointer").withParameter("socket", 0).andReturnValue(0x0000);
+    expectReadBuffer(0x0000, ring);
+
+    std::array<std::uint8_t, 8> buffer{};
+    std::array<std::span<std::uint8_t>, 4> frames{};
+    CHECK_EQUAL(1, socket->receiveFrames(buffer, frames));
+    CHECK_EQUAL(2, frames[0].size());
+}
+
+TEST(MacRawSocketTest, receiveFramesDropsFrameLargerThanBuffer)
+{
+    const std::array<std::uint8_t, 4> ring{{0x00, 0x0a, 0xa1, 0xa2}};
+    expectReceiveSize(10);
+    mock("Device").expectOneCall("readReceivePointer").withParameter("socket", 0).andReturnValue(0x0000);
+    expectReadBuffer(0x0000, ring);
+    expectReceiveDone(0x000a);
+
+    std::array<std::uint8_t, 4> buffer{};
+    std::array<std::span<std::uint8_t>, 4> frames{};
+    CHECK_EQUAL(0, socket->receiveFrames(buffer, frames));
+}
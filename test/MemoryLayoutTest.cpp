@@ -0,0 +1,67 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "w5100/MemoryLayout.h"
+#include <CppUTest/TestHarness.h>
+
+using eth::makeHandle;
+using eth::w5100::defaultMemoryLayout;
+using eth::w5100::MemoryLayout;
+
+TEST_GROUP(MemoryLayoutTest)
+{
+};
+
+TEST(MemoryLayoutTest, defaultLayout)
+{
+    constexpr auto layout = defaultMemoryLayout;
+    CHECK_EQUAL(0x55, layout.transmitMemorySize());
+    CHECK_EQUAL(0x55, layout.receiveMemorySize());
+    CHECK_EQUAL(2048, layout.transmitBufferSize(makeHandle<3>()));
+    CHECK_EQUAL(2048, layout.receiveBufferSize(makeHandle<3>()));
+    CHECK_EQUAL(0x5800, layout.transmitBufferAddress(makeHandle<3>()));
+    CHECK_EQUAL(0x7800, layout.receiveBufferAddress(makeHandle<3>()));
+}
+
+TEST(MemoryLayoutTest, singleSocketLayout)
+{
+    constexpr MemoryLayout layout{{{8, 0, 0, 0}}, {{8, 0, 0, 0}}};
+    CHECK_EQUAL(0x03, layout.transmitMemorySize());
+    CHECK_EQUAL(8192, layout.transmitBufferSize(makeHandle<0>()));
+    CHECK_EQUAL(0, layout.transmitBufferSize(makeHandle<1>()));
+    CHECK_EQUAL(0x4000, layout.transmitBufferAddress(makeHandle<0>()));
+    CHECK_EQUAL(0x6000, layout.receiveBufferAddress(makeHandle<0>()));
+}
+
+TEST(MemoryLayoutTest, mixedLayout)
+{
+    constexpr MemoryLayout layout{{{4, 2, 1, 1}}, {{1, 1, 2, 4}}};
+    CHECK_EQUAL(0x06, layout.transmitMemorySize());
+    CHECK_EQUAL(0x90, layout.receiveMemorySize());
+    CHECK_EQUAL(0x4000, layout.transmitBufferAddress(makeHandle<0>()));
+    CHECK_EQUAL(0x5000, layout.transmitBufferAddress(makeHandle<1>()));
+    CHECK_EQUAL(0x5800, layout.transmitBufferAddress(makeHandle<2>()));
+    CHECK_EQUAL(0x5c00, layout.transmitBufferAddress(makeHandle<3>()));
+    CHECK_EQUAL(1024, layout.transmitBufferSize(makeHandle<3>()));
+    CHECK_EQUAL(0x6000, layout.receiveBufferAddress(makeHandle<0>()));
+    CHECK_EQUAL(0x6800, layout.receiveBufferAddress(makeHandle<2>()));
+    CHECK_EQUAL(0x7000, layout.receiveBufferAddress(makeHandle<3>()));
+    CHECK_EQUAL(4096, layout.receiveBufferSize(makeHandle<3>()));
+}
@@ -0,0 +1,294 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mqtt/Client.h"
+#include "sim/MqttBroker.h"
+#include "sim/W5100Simulator.h"
+#include "w5100/Device.h"
+#include "TestHelper.h"
+#include <string_view>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::Socket;
+using eth::mqtt::Client;
+using eth::mqtt::QoS;
+using eth::sim::MqttBroker;
+using eth::sim::W5100Simulator;
+
+
+namespace
+{
+    constexpr auto handle = eth::makeHandle<0>();
+    constexpr eth::NetAddress<4> brokerAddress{{192, 168, 1, 2}};
+    constexpr std::uint16_t brokerPort{1883};
+
+    constexpr std::uint8_t connectType{1};
+    constexpr std::uint8_t publishType{3};
+    constexpr std::uint8_t pingRequestType{12};
+    constexpr std::uint8_t disconnectType{14};
+
+    constexpr std::size_t maxPayloadSize(std::size_t topicSize)
+    {
+        const std::size_t remainingLength = Client::maxPacketSize - 2;
+        const std::size_t lengthSize = (remainingLength <= 127 ? 1 : (remainingLength - 1 <= 16383 ? 2 : 3));
+        return Client::maxPacketSize - 1 - lengthSize - 2 - topicSize - 2;
+    }
+
+    std::span<const std::uint8_t> asBytes(std::string_view text)
+    {
+        return {reinterpret_cast<const std::uint8_t*>(text.data()), text.size()};
+    }
+}
+
+
+TEST_GROUP(MqttClientTest)
+{
+    void setup() override
+    {
+        mock("platform").ignoreOtherCalls();
+        setTime(0);
+    }
+
+    void teardown() override
+    {
+        mock().clear();
+    }
+
+    void setTime(unsigned int milliseconds)
+    {
+        mock("platform").setData("milliseconds", milliseconds);
+    }
+
+    void connect(bool sessionPresent = false)
+    {
+        CHECK_EQUAL(Socket::Status::ok, client.connect(brokerAddress, brokerPort));
+        broker.receive();
+        broker.connack(sessionPresent);
+        CHECK_EQUAL(Socket::Status::ok, client.poll());
+    }
+
+    void publish(std::size_t count, QoS qos)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            CHECK_EQUAL(Socket::Status::ok, client.publish("sensor/temp", asBytes("21.5"), qos));
+        }
+    }
+
+
+    W5100Simulator simulator;
+    eth::w5100::BasicDevice<W5100Simulator> device{simulator};
+    Socket socket{handle, device};
+    Client client{socket, {"sensor-1", 10, false, 49152, 1000}};
+    MqttBroker broker{simulator, handle};
+};
+
+TEST(MqttClientTest, connectSendsConnect)
+{
+    CHECK_EQUAL(Socket::Status::ok, client.connect(brokerAddress, brokerPort));
+
+    const auto packets = broker.receive();
+    CHECK_EQUAL(1, packets.size());
+    CHECK_EQUAL(connectType, packets[0].type);
+    CHECK_FALSE(client.isConnected());
+    CHECK_EQUAL(Socket::Status::wouldBlock, client.poll());
+}
+
+TEST(MqttClientTest, connackCompletesConnect)
+{
+    client.connect(brokerAddress, brokerPort);
+    broker.connack(true);
+
+    CHECK_EQUAL(Socket::Status::ok, client.poll());
+    CHECK_TRUE(client.isConnected());
+    CHECK_TRUE(client.isSessionPresent());
+}
+
+TEST(MqttClientTest, refusedConnectCloses)
+{
+    client.connect(brokerAddress, brokerPort);
+    broker.connack(false, 0x05);
+
+    CHECK_EQUAL(Socket::Status::failed, client.poll());
+    CHECK_FALSE(client.isConnected());
+    CHECK_EQUAL(eth::SocketStatus::closed, simulator.status(handle));
+}
+
+TEST(MqttClientTest, connectTimesOutWithoutConnack)
+{
+    client.connect(brokerAddress, brokerPort);
+    setTime(1000);
+
+    CHECK_EQUAL(Socket::Status::timeout, client.poll());
+    CHECK_FALSE(client.isConnected());
+}
+
+TEST(MqttClientTest, publishesAreBatchedIntoSingleSend)
+{
+    connect();
+    const auto sends = simulator.sendCommands(handle);
+
+    publish(3, QoS::atLeastOnce);
+    publish(1, QoS::atMostOnce);
+    CHECK_EQUAL(Socket::Status::ok, client.flush());
+
+    CHECK_EQUAL(sends + 1, simulator.sendCommands(handle));
+
+    const auto packets = broker.receive();
+    CHECK_EQUAL(4, packets.size());
+    CHECK_EQUAL(1, MqttBroker::decodePublish(packets[0]).packetId);
+    CHECK_EQUAL(2, MqttBroker::decodePublish(packets[1]).packetId);
+    CHECK_EQUAL(3, MqttBroker::decodePublish(packets[2]).packetId);
+    CHECK_EQUAL(0, MqttBroker::decodePublish(packets[3]).packetId);
+    STRCMP_EQUAL("sensor/temp", MqttBroker::decodePublish(packets[3]).topic.c_str());
+    STRCMP_EQUAL("21.5", MqttBroker::decodePublish(packets[3]).payload.c_str());
+    CHECK_EQUAL(4, client.pending());
+}
+
+TEST(MqttClientTest, publishesQueuedUntilConnected)
+{
+    publish(2, QoS::atLeastOnce);
+    CHECK_EQUAL(Socket::Status::wouldBlock, client.flush());
+
+    connect();
+
+    CHECK_EQUAL(2, broker.receive().size());
+}
+
+TEST(MqttClientTest, inflightWindowIsLimited)
+{
+    connect();
+    publish(Client::maxInflight, QoS::atLeastOnce);
+
+    CHECK_EQUAL(Socket::Status::wouldBlock, client.publish("t", asBytes("x"), QoS::atLeastOnce));
+
+    client.poll();
+    broker.puback(1);
+    client.poll();
+
+    CHECK_EQUAL(Client::maxInflight - 1, client.pending());
+    CHECK_EQUAL(Socket::Status::ok, client.publish("t", asBytes("x"), QoS::atLeastOnce));
+}
+
+TEST(MqttClientTest, pubackReleasesWindowInOrder)
+{
+    connect();
+    publish(3, QoS::atLeastOnce);
+    client.poll();
+
+    broker.puback(2);
+    client.poll();
+    CHECK_EQUAL(3, client.pending());
+
+    broker.puback(1);
+    client.poll();
+    CHECK_EQUAL(1, client.pending());
+
+    broker.puback(3);
+    client.poll();
+    CHECK_EQUAL(0, client.pending());
+}
+
+TEST(MqttClientTest, publishFailsIfPacketTooLarge)
+{
+    const std::vector<std::uint8_t> payload(Client::maxPacketSize, 0xaa);
+
+    CHECK_EQUAL(Socket::Status::failed, client.publish("t", payload, QoS::atLeastOnce));
+    CHECK_EQUAL(0, client.pending());
+}
+
+TEST(MqttClientTest, publishOfMaxPacketSizeIsSent)
+{
+    connect();
+    const std::vector<std::uint8_t> payload(maxPayloadSize(1), 'a');
+    const std::vector<std::uint8_t> oversized(payload.size() + 1, 'a');
+
+    CHECK_EQUAL(Socket::Status::failed, client.publish("t", oversized, QoS::atLeastOnce));
+    CHECK_EQUAL(Socket::Status::ok, client.publish("t", payload, QoS::atLeastOnce));
+    CHECK_EQUAL(Socket::Status::ok, client.flush());
+
+    const auto packets = broker.receive();
+    CHECK_EQUAL(1, packets.size());
+    CHECK_EQUAL(payload.size(), MqttBroker::decodePublish(packets[0]).payload.size());
+}
+
+TEST(MqttClientTest, keepAliveSendsPing)
+{
+    connect();
+
+    setTime(9999);
+    CHECK_EQUAL(Socket::Status::ok, client.poll());
+    CHECK_EQUAL(0, broker.receive().size());
+
+    setTime(10000);
+    CHECK_EQUAL(Socket::Status::ok, client.poll());
+    const auto packets = broker.receive();
+    CHECK_EQUAL(1, packets.size());
+    CHECK_EQUAL(pingRequestType, packets[0].type);
+
+    broker.pingresp();
+    setTime(11000);
+    CHECK_EQUAL(Socket::Status::ok, client.poll());
+    CHECK_TRUE(client.isConnected());
+}
+
+TEST(MqttClientTest, missingPingResponseCloses)
+{
+    connect();
+    setTime(10000);
+    client.poll();
+
+    setTime(11000);
+    CHECK_EQUAL(Socket::Status::timeout, client.poll());
+    CHECK_FALSE(client.isConnected());
+}
+
+TEST(MqttClientTest, reconnectResumesSession)
+{
+    connect();
+    publish(2, QoS::atLeastOnce);
+    client.poll();
+    broker.receive();
+
+    simulator.closeByPeer(handle);
+    CHECK_EQUAL(Socket::Status::closed, client.poll());
+
+    connect(true);
+
+    const auto packets = broker.receive();
+    CHECK_EQUAL(2, packets.size());
+    CHECK_EQUAL(publishType, packets[0].type);
+    CHECK_TRUE(MqttBroker::decodePublish(packets[0]).dup);
+    CHECK_EQUAL(1, MqttBroker::decodePublish(packets[0]).packetId);
+    CHECK_EQUAL(2, MqttBroker::decodePublish(packets[1]).packetId);
+}
+
+TEST(MqttClientTest, disconnectSendsDisconnect)
+{
+    connect();
+    client.disconnect();
+
+    const auto packets = broker.receive();
+    CHECK_EQUAL(1, packets.size());
+    CHECK_EQUAL(disconnectType, packets[0].type);
+    CHECK_FALSE(client.isConnected());
+    CHECK_EQUAL(Socket::Status::closed, client.poll());
+}
@@ -0,0 +1,131 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mqtt/Packet.h"
+#include <array>
+#include <vector>
+#include <CppUTest/TestHarness.h>
+
+using eth::mqtt::FixedHeader;
+using eth::mqtt::PacketType;
+using eth::mqtt::QoS;
+
+
+namespace
+{
+    std::span<const std::uint8_t> asBytes(std::string_view text)
+    {
+        return {reinterpret_cast<const std::uint8_t*>(text.data()), text.size()};
+    }
+
+    std::vector<std::uint8_t> toVector(std::span<const std::uint8_t> data, std::size_t size)
+    {
+        return {data.begin(), std::next(data.begin(), size)};
+    }
+}
+
+
+TEST_GROUP(MqttPacketTest)
+{
+    std::array<std::uint8_t, 256> buffer{};
+};
+
+TEST(MqttPacketTest, encodeConnect)
+{
+    const std::vector<std::uint8_t> expected{
+        {0x10, 15, 0x00, 0x04, 'M', 'Q', 'T', 'T', 0x04, 0x02, 0x00, 60, 0x00, 0x03, 'd', 'e', 'v'}};
+
+    const auto size = eth::mqtt::encodeConnect(buffer, {"dev", 60, true});
+    CHECK_TRUE(expected == toVector(buffer, size));
+}
+
+TEST(MqttPacketTest, encodeConnectWithoutCleanSession)
+{
+    const auto size = eth::mqtt::encodeConnect(buffer, {"dev", 10, false});
+
+    CHECK_EQUAL(17, size);
+    CHECK_EQUAL(0x00, buffer[9]);
+    CHECK_EQUAL(10, buffer[11]);
+}
+
+TEST(MqttPacketTest, encodePublishAtMostOnce)
+{
+    const std::vector<std::uint8_t> expected{{0x30, 5, 0x00, 0x01, 't', 'a', 'b'}};
+
+    const auto size = eth::mqtt::encodePublish(buffer, "t", asBytes("ab"), QoS::atMostOnce, 0);
+    CHECK_TRUE(expected == toVector(buffer, size));
+}
+
+TEST(MqttPacketTest, encodePublishAtLeastOnce)
+{
+    const std::vector<std::uint8_t> expected{{0x32, 7, 0x00, 0x01, 't', 0x01, 0x02, 'a', 'b'}};
+
+    const auto size = eth::mqtt::encodePublish(buffer, "t", asBytes("ab"), QoS::atLeastOnce, 0x0102);
+    CHECK_TRUE(expected == toVector(buffer, size));
+}
+
+TEST(MqttPacketTest, encodePublishWithMultiByteLength)
+{
+    const std::vector<std::uint8_t> payload(200, 0xaa);
+
+    const auto size = eth::mqtt::encodePublish(buffer, "t", payload, QoS::atMostOnce, 0);
+    CHECK_EQUAL(206, size);
+    CHECK_EQUAL(0xcb, buffer[1]);
+    CHECK_EQUAL(0x01, buffer[2]);
+}
+
+TEST(MqttPacketTest, encodeFailsIfBufferTooSmall)
+{
+    std::array<std::uint8_t, 6> small{};
+
+    CHECK_EQUAL(0, eth::mqtt::encodePublish(small, "t", asBytes("ab"), QoS::atMostOnce, 0));
+    CHECK_EQUAL(0, eth::mqtt::encodeConnect(small, {"dev", 60, true}));
+}
+
+TEST(MqttPacketTest, decodeFixedHeader)
+{
+    const std::array<std::uint8_t, 4> data{{0x40, 0x02, 0x00, 0x01}};
+    FixedHeader header{};
+
+    CHECK_EQUAL(2, eth::mqtt::decodeFixedHeader(data, header));
+    CHECK_TRUE(PacketType::puback == header.type);
+    CHECK_EQUAL(0, header.flags);
+    CHECK_EQUAL(2, header.remainingLength);
+}
+
+TEST(MqttPacketTest, decodeFixedHeaderWithMultiByteLength)
+{
+    const std::array<std::uint8_t, 3> data{{0x3a, 0xcb, 0x01}};
+    FixedHeader header{};
+
+    CHECK_EQUAL(3, eth::mqtt::decodeFixedHeader(data, header));
+    CHECK_TRUE(PacketType::publish == header.type);
+    CHECK_EQUAL(0x0a, header.flags);
+    CHECK_EQUAL(203, header.remainingLength);
+}
+
+TEST(MqttPacketTest, decodeIncompleteFixedHeader)
+{
+    const std::array<std::uint8_t, 2> data{{0x30, 0x80}};
+    FixedHeader header{};
+
+    CHECK_EQUAL(0, eth::mqtt::decodeFixedHeader(data, header));
+    CHECK_EQUAL(0, eth::mqtt::decodeFixedHeader(std::span{data}.first(1), header));
+}
@@ -0,0 +1,109 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spi/RegisterTransport.h"
+#include "sim/FakeSpiPeripheral.h"
+#include "sim/W5100Simulator.h"
+#include "w5100/Device.h"
+#include "Socket.h"
+#include "TestHelper.h"
+#include <vector>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::sim::FakeSpiPeripheral;
+using eth::sim::W5100Simulator;
+
+using Transport = eth::spi::BasicRegisterTransport<FakeSpiPeripheral::SpiRegisters, FakeSpiPeripheral::GpioRegisters>;
+using Frames = std::vector<std::vector<std::uint8_t>>;
+
+
+namespace
+{
+    constexpr std::uint16_t slaveSelectPin{GPIO_PIN_12};
+    constexpr std::uint16_t gatewayAddress{0x0001};
+}
+
+
+TEST_GROUP(RegisterTransportTest)
+{
+    void setup() override
+    {
+        mock("platform").ignoreOtherCalls();
+    }
+
+    void teardown() override
+    {
+        mock().clear();
+    }
+
+
+    W5100Simulator simulator;
+    FakeSpiPeripheral peripheral{simulator, slaveSelectPin};
+    Transport transport{peripheral.spi, peripheral.gpio, slaveSelectPin};
+};
+
+TEST(RegisterTransportTest, constructorEnablesPeripheral)
+{
+    CHECK_TRUE((peripheral.spi.CR1 & SPI_CR1_SPE) != 0);
+    CHECK_FALSE(peripheral.isSelected());
+}
+
+TEST(RegisterTransportTest, writeTransmitsFrameUnderSlaveSelect)
+{
+    transport.write(gatewayAddress, 0xc0);
+
+    CHECK_TRUE((peripheral.frames() == Frames{{0xf0, 0x00, 0x01, 0xc0}}));
+    CHECK_FALSE(peripheral.isSelected());
+    CHECK_EQUAL(0xc0, simulator.read(gatewayAddress));
+}
+
+TEST(RegisterTransportTest, readReceivesLastByteOfFrame)
+{
+    simulator.write(gatewayAddress, 0xa8);
+
+    CHECK_EQUAL(0xa8, transport.read(gatewayAddress));
+    CHECK_TRUE((peripheral.frames() == Frames{{0x0f, 0x00, 0x01, 0x00}}));
+    CHECK_FALSE(peripheral.isSelected());
+}
+
+TEST(RegisterTransportTest, blockTransfersUseOneFramePerByte)
+{
+    const std::array<std::uint8_t, 4> data{{192, 168, 1, 1}};
+    transport.writeBlock(gatewayAddress, data);
+
+    std::array<std::uint8_t, 4> buffer{};
+    transport.readBlock(gatewayAddress, buffer);
+
+    CHECK_TRUE(data == buffer);
+    CHECK_EQUAL(8, peripheral.frames().size());
+    CHECK_TRUE((peripheral.frames()[3] == std::vector<std::uint8_t>{0xf0, 0x00, 0x04, 0x01}));
+    CHECK_TRUE((peripheral.frames()[7] == std::vector<std::uint8_t>{0x0f, 0x00, 0x04, 0x00}));
+}
+
+TEST(RegisterTransportTest, deviceRunsOnRegisterTransport)
+{
+    eth::w5100::BasicDevice<Transport> device{transport};
+    eth::Socket socket{eth::makeHandle<1>(), device};
+
+    CHECK_EQUAL(eth::Socket::Status::ok, socket.open(eth::Protocol::tcp, 5000, 0));
+    CHECK_EQUAL(eth::Socket::Status::ok, socket.connect({{192, 168, 0, 5}}, 6000));
+    CHECK_EQUAL(eth::SocketStatus::established, simulator.status(eth::makeHandle<1>()));
+}
@@ -0,0 +1,210 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SocketTable.h"
+#include "sim/W5100Simulator.h"
+#include "w5100/Device.h"
+#include "TestHelper.h"
+#include <algorithm>
+#include <array>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::Protocol;
+using eth::SocketHandle;
+using eth::SocketInterrupt;
+using eth::SocketStatus;
+using eth::SocketTable;
+using eth::sim::W5100Simulator;
+
+
+namespace
+{
+    constexpr std::uint16_t port{5000};
+    constexpr eth::NetAddress<4> address{{192, 168, 0, 5}};
+}
+
+
+TEST_GROUP(SocketTableTest)
+{
+    void setup() override
+    {
+        mock("platform").ignoreOtherCalls();
+    }
+
+    void teardown() override
+    {
+        mock().clear();
+    }
+
+
+    W5100Simulator simulator;
+    eth::w5100::BasicDevice<W5100Simulator> device{simulator};
+    SocketTable table{device};
+};
+
+TEST(SocketTableTest, allSocketsAvailableInitially)
+{
+    CHECK_EQUAL(eth::supportedSockets, table.available());
+    CHECK_FALSE(table.isAllocated(eth::makeHandle<0>()));
+}
+
+TEST(SocketTableTest, allocateOpensLowestFreeSocket)
+{
+    const auto s = table.allocate(Protocol::tcp, port);
+
+    CHECK_TRUE(s.has_value());
+    CHECK_EQUAL(0, s->value());
+    CHECK_TRUE(table.isAllocated(*s));
+    CHECK_EQUAL(Protocol::tcp, table.protocol(*s));
+    CHECK_EQUAL(port, table.localPort(*s));
+    CHECK_EQUAL(SocketStatus::init, simulator.status(*s));
+    CHECK_EQUAL(eth::supportedSockets - 1, table.available());
+}
+
+TEST(SocketTableTest, allocateFailsIfExhausted)
+{
+    for (std::uint8_t i = 0; i < eth::supportedSockets; ++i)
+    {
+        CHECK_EQUAL(i, table.allocate(Protocol::udp, port + i)->value());
+    }
+
+    CHECK_FALSE(table.allocate(Protocol::udp, port).has_value());
+    CHECK_EQUAL(0, table.available());
+}
+
+TEST(SocketTableTest, releaseClosesAndFreesSocket)
+{
+    table.allocate(Protocol::tcp, port);
+    const auto s = table.allocate(Protocol::tcp, port + 1);
+    table.allocate(Protocol::tcp, port + 2);
+
+    table.release(*s);
+
+    CHECK_FALSE(table.isAllocated(*s));
+    CHECK_EQUAL(SocketStatus::closed, simulator.status(*s));
+    CHECK_EQUAL(1, table.allocate(Protocol::udp, port)->value());
+}
+
+TEST(SocketTableTest, commandsIgnoreFreeSockets)
+{
+    const auto s = eth::makeHandle<2>();
+
+    table.listen(s);
+    table.connect(s, address, 6000);
+    CHECK_EQUAL(SocketStatus::closed, simulator.status(s));
+    CHECK_EQUAL(0, table.remotePort(s));
+
+    device.writeSocketModeRegister(s, static_cast<std::uint8_t>(Protocol::tcp));
+    device.executeSocketCommand(s, eth::SocketCommand::open);
+    device.executeSocketCommand(s, eth::SocketCommand::listen);
+    simulator.acceptConnection(s);
+    table.disconnect(s);
+    CHECK_EQUAL(SocketStatus::established, simulator.status(s));
+}
+
+TEST(SocketTableTest, pollSweepsAllocatedSockets)
+{
+    const auto s = table.allocate(Protocol::tcp, port);
+    table.connect(*s, address, 6000);
+
+    CHECK_EQUAL(1, table.poll());
+    CHECK_EQUAL(SocketStatus::established, table.status(*s));
+    CHECK_TRUE(table.pending(*s).test(SocketInterrupt::Mask::connect));
+    CHECK_TRUE(address == table.remoteAddress(*s));
+    CHECK_EQUAL(6000, table.remotePort(*s));
+    CHECK_EQUAL(2048, table.transmitFreeSize(*s));
+    CHECK_EQUAL(0, device.readSocketInterruptRegister(*s).value());
+}
+
+TEST(SocketTableTest, pollUpdatesReceivedSize)
+{
+    const auto s = table.allocate(Protocol::tcp, port);
+    table.connect(*s, address, 6000);
+    const std::array<std::uint8_t, 5> data{{1, 2, 3, 4, 5}};
+    simulator.injectReceive(*s, data);
+
+    table.poll();
+
+    CHECK_EQUAL(data.size(), table.receivedSize(*s));
+    CHECK_TRUE(table.pending(*s).test(SocketInterrupt::Mask::receive));
+}
+
+TEST(SocketTableTest, pendingEventsKeptUntilCleared)
+{
+    const auto s = table.allocate(Protocol::tcp, port);
+    table.connect(*s, address, 6000);
+    table.poll();
+
+    CHECK_EQUAL(1, table.poll());
+
+    table.clearPending(*s, SocketInterrupt::Mask::connect);
+    CHECK_EQUAL(0, table.poll());
+    CHECK_EQUAL(0, table.pending(*s).value());
+}
+
+TEST(SocketTableTest, pollSkipsFreeSockets)
+{
+    const auto s = table.allocate(Protocol::tcp, port);
+    table.release(*s);
+    simulator.acceptConnection(*s);
+
+    CHECK_EQUAL(0, table.poll());
+    CHECK_EQUAL(SocketStatus::closed, table.status(*s));
+}
+
+TEST(SocketTableTest, allocateFailsIfOpenDoesNotComplete)
+{
+    CHECK_FALSE(table.allocate(Protocol::ipRaw, port).has_value());
+    CHECK_FALSE(table.isAllocated(eth::makeHandle<0>()));
+    CHECK_EQUAL(eth::supportedSockets, table.available());
+}
+
+TEST(SocketTableTest, sendAndReceiveOverAllocatedSocket)
+{
+    const auto s = table.allocate(Protocol::tcp, port);
+    table.connect(*s, address, 6000);
+    const std::array<std::uint8_t, 4> data{{1, 2, 3, 4}};
+    simulator.injectReceive(*s, data);
+
+    const auto sent = table.trySend(*s, data);
+    CHECK_EQUAL(eth::Socket::Status::ok, sent.status);
+    CHECK_EQUAL(data.size(), sent.size);
+    const auto transmitted = simulator.takeTransmitted(*s);
+    CHECK_TRUE(std::equal(data.cbegin(), data.cend(), transmitted.cbegin(), transmitted.cend()));
+
+    std::array<std::uint8_t, 8> buffer{};
+    const auto received = table.tryReceive(*s, buffer);
+    CHECK_EQUAL(eth::Socket::Status::ok, received.status);
+    CHECK_EQUAL(data.size(), received.size);
+    CHECK_TRUE(std::equal(data.cbegin(), data.cend(), buffer.cbegin()));
+    CHECK_EQUAL(eth::Socket::Status::wouldBlock, table.tryReceive(*s, buffer).status);
+}
+
+TEST(SocketTableTest, sendAndReceiveRejectNotConnectedSockets)
+{
+    const auto s = table.allocate(Protocol::tcp, port);
+    std::array<std::uint8_t, 4> buffer{};
+
+    CHECK_EQUAL(eth::Socket::Status::closed, table.trySend(*s, buffer).status);
+    CHECK_EQUAL(eth::Socket::Status::closed, table.tryReceive(*s, buffer).status);
+    CHECK_EQUAL(eth::Socket::Status::failed, table.trySend(eth::makeHandle<1>(), buffer).status);
+    CHECK_EQUAL(eth::Socket::Status::failed, table.tryReceive(eth::makeHandle<1>(), buffer).status);
+}
@@ -22,8 +22,7 @@
 #include "SocketStatus.h"
 #include "SocketCommand.h"
 #include "SocketInterrupt.h"
-#include "w5100/Device.h"
-#include "spi/SpiWriter.h"
+#include "mock/NetDeviceMock.h"
 #include "TestHelper.h"
 #include <vector>
 #include <memory>
@@ -37,8 +36,7 @@ using eth::SocketCommand;
 using eth::SocketHandle;
 using eth::SocketInterrupt;
 using eth::SocketStatus;
-using eth::spi::SpiWriter;
-using eth::w5100::Device;
+using eth::test::NetDeviceMock;
 
 
 namespace
@@ -57,8 +55,7 @@ TEST_GROUP(SocketTest)
 
     void setup() override
     {
-        device = std::make_unique<Device>(spi);
-        socket = std::make_unique<Socket>(socketHandle, *device);
+        socket = std::make_unique<Socket>(socketHandle, device);
         mock().strictOrder();
     }
 
@@ -121,8 +118,7 @@ TEST_GROUP(SocketTest)
 
 
     std::unique_ptr<Socket> socket;
-    SpiWriter spi{eth::spi::spi2};
-    std::unique_ptr<Device> device;
+    NetDeviceMock device;
     static inline constexpr std::uint16_t port{1234};
     static inline constexpr Protocol protocol = Protocol::tcp;
     static inline constexpr std::uint8_t flag{0};
@@ -258,7 +254,7 @@ TEST(SocketTest, closedOnDestruction)
         .expectOneCall("writeSocketInterruptRegister")
         .withParameter("socket", socketHandle.value())
         .withParameter("value", 0xff);
-    Socket s(socketHandle, *device);
+    Socket s(socketHandle, device);
 }
 
 TEST(SocketTest, listenReturnsErrorIfStatusNotInit)
@@ -311,7 +307,7 @@ TEST(SocketTest, sendReturnsBytesTransmitted)
 
 TEST(SocketTest, sendIgnoresEmptyBuffer)
 {
-    const auto result = socket->send({});
+    const auto result = socket->send(std::span<const std::uint8_t>{});
     CHECK_EQUAL(0, result);
 }
 
@@ -327,6 +323,22 @@ TEST(SocketTest, sendLimitsBufferSize)
     CHECK_EQUAL(maxSendSize, result);
 }
 
+TEST(SocketTest, sendLimitsToSocketBufferSize)
+{
+    NetDeviceMock customDevice{8192, 8192};
+    Socket customSocket{socketHandle, customDevice};
+    constexpr std::uint16_t maxSendSize{8192};
+    expectWaitForFreeRxTx(Mode::send, socketHandle, maxSendSize);
+    mock("Device").expectOneCall("sendData").withParameter("size", maxSendSize).ignoreOtherParameters();
+    mock("Device").expectOneCall("executeSocketCommand").ignoreOtherParameters();
+
+    const auto buffer = createBuffer(maxSendSize + 1);
+    const auto result = customSocket.send(buffer);
+    CHECK_EQUAL(maxSendSize, result);
+
+    mock().disable();
+}
+
 TEST(SocketTest, sendChecksFreesizeAndStatusFlagIfEstablished)
 {
     constexpr std::uint16_t freeSize = defaultSize + 2;
@@ -642,3 +654,265 @@ TEST(SocketTest, disconnectErrorOnTimeout)
     const auto rtn = socket->disconnect();
     CHECK_EQUAL(Socket::Status::timeout, rtn);
 }
+
+TEST(SocketTest, tryAcceptWouldBlockWhileListening)
+{
+    expectSocketStatusRead(socketHandle, SocketStatus::listen);
+    expectSocketStatusRead(socketHandle, SocketStatus::synRecv);
+
+    CHECK_EQUAL(Socket::Status::wouldBlock, socket->tryAccept());
+    CHECK_EQUAL(Socket::Status::wouldBlock, socket->tryAccept());
+}
+
+TEST(SocketTest, tryAcceptReturnsOkIfEstablished)
+{
+    expectSocketStatusRead(socketHandle, SocketStatus::established);
+    CHECK_EQUAL(Socket::Status::ok, socket->tryAccept());
+}
+
+TEST(SocketTest, tryAcceptReturnsClosedIfNotListening)
+{
+    expectSocketStatusRead(socketHandle, SocketStatus::closed);
+    CHECK_EQUAL(Socket::Status::closed, socket->tryAccept());
+}
+
+TEST(SocketTest, trySendSendsFreeSize)
+{
+    constexpr std::uint16_t freeSize{3};
+    expectWaitForFreeRxTx(Mode::send, socketHandle, freeSize);
+    mock("Device").expectOneCall("sendData").withParameter("size", freeSize).ignoreOtherParameters();
+    expectSocketCommand(socketHandle, SocketCommand::send);
+
+    const auto buffer = createBuffer(defaultSize);
+    const auto result = socket->trySend(buffer);
+    CHECK_EQUAL(Socket::Status::ok, result.status);
+    CHECK_EQUAL(freeSize, result.size);
+}
+
+TEST(SocketTest, trySendWouldBlockIfNoFreeMemory)
+{
+    expectWaitForFreeRxTx(Mode::send, socketHandle, 0);
+
+    const auto buffer = createBuffer(defaultSize);
+    const auto result = socket->trySend(buffer);
+    CHECK_EQUAL(Socket::Status::wouldBlock, result.status);
+    CHECK_EQUAL(0, result.size);
+}
+
+TEST(SocketTest, trySendReturnsClosedIfNotConnected)
+{
+    expectSocketStatusRead(socketHandle, SocketStatus::closed);
+
+    const auto buffer = createBuffer(defaultSize);
+    const auto result = socket->trySend(buffer);
+    CHECK_EQUAL(Socket::Status::closed, result.status);
+}
+
+TEST(SocketTest, tryReceiveReceivesAvailableData)
+{
+    constexpr std::uint16_t available{2};
+    expectWaitForFreeRxTx(Mode::receive, socketHandle, available);
+    mock("Device").expectOneCall("receiveData").withParameter("size", available).ignoreOtherParameters().andReturnValue(available);
+    expectSocketCommand(socketHandle, SocketCommand::receive);
+
+    std::array<std::uint8_t, defaultSize> data{};
+    const auto result = socket->tryReceive(data);
+    CHECK_EQUAL(Socket::Status::ok, result.status);
+    CHECK_EQUAL(available, result.size);
+}
+
+TEST(SocketTest, tryReceiveWouldBlockIfNoData)
+{
+    expectWaitForFreeRxTx(Mode::receive, socketHandle, 0);
+
+    std::array<std::uint8_t, defaultSize> data{};
+    const auto result = socket->tryReceive(data);
+    CHECK_EQUAL(Socket::Status::wouldBlock, result.status);
+}
+
+TEST(SocketTest, tryReceiveReturnsClosedIfPeerClosedAndNoData)
+{
+    expectSocketStatusRead(socketHandle, SocketStatus::closeWait);
+    mock("Device").expectOneCall("getReceiveFreeSize").withParameter("socket", socketHandle.value()).andReturnValue(0);
+
+    std::array<std::uint8_t, defaultSize> data{};
+    const auto result = socket->tryReceive(data);
+    CHECK_EQUAL(Socket::Status::closed, result.status);
+}
+
+TEST(SocketTest, startConnectIssuesConnect)
+{
+    const NetAddress<4> addr{{127, 0, 0, 1}};
+    mock("Device").expectOneCall("setDestAddress").ignoreOtherParameters();
+    expectSocketCommand(socketHandle, SocketCommand::connect);
+
+    CHECK_EQUAL(Socket::Status::wouldBlock, socket->startConnect(addr, 4567));
+}
+
+TEST(SocketTest, pollConnectChecksStatusOnce)
+{
+    expectSocketStatusRead(socketHandle, SocketStatus::synSent);
+    expectSocketInterruptRead(socketHandle, 0x00u);
+    expectSocketStatusRead(socketHandle, SocketStatus::established);
+
+    CHECK_EQUAL(Socket::Status::wouldBlock, socket->pollConnect());
+    CHECK_EQUAL(Socket::Status::ok, socket->pollConnect());
+}
+
+TEST(SocketTest, pollConnectErrors)
+{
+    expectSocketStatusRead(socketHandle, SocketStatus::closed);
+    expectSocketStatusRead(socketHandle, SocketStatus::synSent);
+    expectSocketInterruptRead(socketHandle, SocketInterrupt::Mask::timeout);
+
+    CHECK_EQUAL(Socket::Status::closed, socket->pollConnect());
+    CHECK_EQUAL(Socket::Status::timeout, socket->pollConnect());
+}
+
+TEST(SocketTest, startAndPollDisconnect)
+{
+    expectSocketCommand(socketHandle, SocketCommand::disconnect);
+    expectSocketStatusRead(socketHandle, SocketStatus::finWait);
+    expectSocketInterruptRead(socketHandle, 0x00u);
+    expectSocketStatusRead(socketHandle, SocketStatus::closed);
+
+    CHECK_EQUAL(Socket::Status::wouldBlock, socket->startDisconnect());
+    CHECK_EQUAL(Socket::Status::wouldBlock, socket->pollDisconnect());
+    CHECK_EQUAL(Socket::Status::ok, socket->pollDisconnect());
+}
+
+TEST(SocketTest, pollDisconnectErrorOnTimeout)
+{
+    expectSocketStatusRead(socketHandle, SocketStatus::finWait);
+    expectSocketInterruptRead(socketHandle, SocketInterrupt::Mask::timeout);
+
+    CHECK_EQUAL(Socket::Status::timeout, socket->pollDisconnect());
+}
+
+TEST(SocketTest, peekReturnsEmptyViewWithoutData)
+{
+    mock("Device").expectOneCall("getReceiveFreeSize").withParameter("socket", socketHandle.value()).andReturnValue(0);
+
+    const auto view = socket->peek();
+    CHECK_EQUAL(0, view.size);
+}
+
+TEST(SocketTest, peekDescribesAvailableData)
+{
+    mock("Device").expectOneCall("getReceiveFreeSize").withParameter("socket", socketHandle.value()).andReturnValue(20);
+    mock("Device").expectOneCall("readReceivePointer").withParameter("socket", socketHandle.value()).andReturnValue(0x0ff8);
+
+    const auto view = socket->peek();
+    CHECK_EQUAL(0x0ff8, view.pointer);
+    CHECK_EQUAL(20, view.size);
+    CHECK_EQUAL(0x67f8, view.segments[0].address);
+    CHECK_EQUAL(8, view.segments[0].size);
+    CHECK_EQUAL(0x6000, view.segments[1].address);
+    CHECK_EQUAL(12, view.segments[1].size);
+}
+
+TEST(SocketTest, readReadsFromViewWithoutConsuming)
+{
+    const Socket::ReceiveView view{0x0100, 20, {}};
+    const auto expected = createBuffer(4);
+    mock("Device")
+        .expectOneCall("readReceiveBuffer")
+        .withParameter("socket", socketHandle.value())
+        .withParameter("pointer", 0x0110)
+        .withOutputParameterReturning("buffer", expected.data(), expected.size())
+        .withParameter("size", expected.size());
+
+    std::array<std::uint8_t, 8> buffer{};
+    CHECK_EQUAL(4, socket->read(view, 16, buffer));
+    CHECK_TRUE(std::equal(expected.begin(), expected.end(), buffer.begin()));
+    CHECK_EQUAL(0, socket->read(view, 20, buffer));
+}
+
+TEST(SocketTest, consumeAdvancesReadPointer)
+{
+    const Socket::ReceiveView view{0xfff0, 20, {}};
+    mock("Device").expectOneCall("writeReceivePointer").withParameter("socket", socketHandle.value()).withParameter("value", 0x0004);
+    expectSocketCommand(socketHandle, SocketCommand::receive);
+
+    socket->consume(view, 100);
+}
+
+TEST(SocketTest, consumeNothingIssuesNoCommand)
+{
+    const Socket::ReceiveView view{0x0100, 20, {}};
+    socket->consume(view, 0);
+}
+
+TEST(SocketTest, sendSegmentsSendsAllSegmentsWithSingleCommand)
+{
+    const auto header = createBuffer(4);
+    const auto body = createBuffer(10);
+    const std::array<std::span<const std::uint8_t>, 2> segments{{header, body}};
+    expectWaitForFreeRxTx(Mode::send, socketHandle, 100);
+    mock("Device")
+        .expectOneCall("sendSegments")
+        .withParameter("socket", socketHandle.value())
+        .withParameter("segments", segments.size())
+        .withParameter("size", 14);
+    expectSocketCommand(socketHandle, SocketCommand::send);
+
+    CHECK_EQUAL(14, socket->send(segments));
+}
+
+TEST(SocketTest, sendSegmentsRejectsMessageLargerThanBuffer)
+{
+    const auto header = createBuffer(48);
+    const auto body = createBuffer(2001);
+    const std::array<std::span<const std::uint8_t>, 2> segments{{header, body}};
+
+    CHECK_EQUAL(0, socket->send(segments));
+}
+
+TEST(SocketTest, trySendSegmentsSendsAllIfFree)
+{
+    const auto header = createBuffer(4);
+    const auto body = createBuffer(10);
+    const std::array<std::span<const std::uint8_t>, 2> segments{{header, body}};
+    expectWaitForFreeRxTx(Mode::send, socketHandle, 100);
+    mock("Device")
+        .expectOneCall("sendSegments")
+        .withParameter("socket", socketHandle.value())
+        .withParameter("segments", segments.size())
+        .withParameter("size", 14);
+    expectSocketCommand(socketHandle, SocketCommand::send);
+
+    const auto result = socket->trySend(std::span<const std::span<const std::uint8_t>>{segments});
+    CHECK_EQUAL(Socket::Status::ok, result.status);
+    CHECK_EQUAL(14, result.size);
+}
+
+TEST(SocketTest, trySendSegmentsSendsFreeSize)
+{
+    const auto header = createBuffer(4);
+    const auto body = createBuffer(10);
+    const std::array<std::span<const std::uint8_t>, 2> segments{{header, body}};
+    expectWaitForFreeRxTx(Mode::send, socketHandle, 6);
+    mock("Device").expectOneCall("sendData").withParameter("size", 4).ignoreOtherParameters();
+    mock("Device").expectOneCall("sendData").withParameter("size", 2).ignoreOtherParameters();
+    expectSocketCommand(socketHandle, SocketCommand::send);
+
+    const auto result = socket->trySend(std::span<const std::span<const std::uint8_t>>{segments});
+    CHECK_EQUAL(Socket::Status::ok, result.status);
+    CHECK_EQUAL(6, result.size);
+}
+
+TEST(SocketTest, trySendSegmentsWouldBlockIfNoFreeMemory)
+{
+    const auto body = createBuffer(10);
+    const std::array<std::span<const std::uint8_t>, 1> segments{{body}};
+    expectWaitForFreeRxTx(Mode::send, socketHandle, 0);
+
+    const auto result = socket->trySend(std::span<const std::span<const std::uint8_t>>{segments});
+    CHECK_EQUAL(Socket::Status::wouldBlock, result.status);
+}
+
+TEST(SocketTest, sendSegmentsIgnoresEmptySegments)
+{
+    const std::array<std::span<const std::uint8_t>, 2> segments{};
+    CHECK_EQUAL(0, socket->send(segments));
+}
@@ -0,0 +1,276 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spi/SpiDma.h"
+#include "spi/SpiWriter.h"
+#include <array>
+#include <memory>
+#include <span>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::spi::SpiDma;
+using eth::spi::SpiWriter;
+
+namespace
+{
+    SpiDma* activeDma{nullptr};
+    bool lastResult{false};
+
+    void onComplete(void* context, bool success)
+    {
+        auto* count = static_cast<int*>(context);
+        ++(*count);
+        lastResult = success;
+    }
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    activeDma->onComplete(hspi);
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    activeDma->onComplete(hspi);
+}
+
+TEST_GROUP(SpiDmaTest)
+{
+    void setup() override
+    {
+        mock().strictOrder();
+
+        mock().disable();
+        spiWriter = std::make_unique<SpiWriter>(eth::spi::spi2);
+        dma = std::make_unique<SpiDma>(*spiWriter, eth::spi::spi2Dma);
+        mock().enable();
+        activeDma = dma.get();
+        lastResult = false;
+    }
+
+    void teardown() override
+    {
+        mock().checkExpectations();
+        mock().clear();
+    }
+
+    void expectTransmit(std::span<const std::uint8_t> data) const
+    {
+        mock("HAL_SPI")
+            .expectOneCall("HAL_SPI_Transmit_DMA")
+            .withPointerParameter("hspi", &spiWriter->nativeHandle())
+            .withMemoryBufferParameter("pData", data.data(), data.size())
+            .withParameter("Size", data.size());
+    }
+
+    void expectTransmitReceive(std::span<const std::uint8_t> data, std::span<const std::uint8_t> received) const
+    {
+        mock("HAL_SPI")
+            .expectOneCall("HAL_SPI_TransmitReceive_DMA")
+            .withPointerParameter("hspi", &spiWriter->nativeHandle())
+            .withMemoryBufferParameter("pTxData", data.data(), data.size())
+            .withOutputParameterReturning("pRxData", received.data(), received.size())
+            .withParameter("Size", data.size());
+    }
+
+    void expectSlaveSelect(GPIO_PinState state) const
+    {
+        mock("HAL_GPIO")
+            .expectOneCall("HAL_GPIO_WritePin")
+            .withPointerParameter("GPIOx", GPIOB)
+            .withParameter("GPIO_Pin", GPIO_PIN_12)
+            .withParameter("PinState", state);
+    }
+
+    void expectFrame(std::span<const std::uint8_t> data) const
+    {
+        expectSlaveSelect(GPIO_PIN_RESET);
+        expectTransmit(data);
+    }
+
+    void expectInterrupt() const
+    {
+        mock("HAL_DMA").expectOneCall("HAL_DMA_IRQHandler").ignoreOtherParameters();
+        expectSlaveSelect(GPIO_PIN_SET);
+    }
+
+    std::unique_ptr<SpiWriter> spiWriter;
+    std::unique_ptr<SpiDma> dma;
+    int completions{0};
+};
+
+TEST(SpiDmaTest, initSetupsDmaStreams)
+{
+    mock().disable();
+    SpiWriter writer{eth::spi::spi2};
+    mock().enable();
+
+    mock("HAL_DMA")
+        .expectOneCall("HAL_DMA_Init")
+        .withPointerParameter("hdma.instance", DMA1_Stream4)
+        .withParameter("hdma.channel", DMA_CHANNEL_0)
+        .withParameter("hdma.direction", DMA_MEMORY_TO_PERIPH)
+        .ignoreOtherParameters();
+    mock("HAL_DMA")
+        .expectOneCall("HAL_DMA_Init")
+        .withPointerParameter("hdma.instance", DMA1_Stream3)
+        .withParameter("hdma.channel", DMA_CHANNEL_0)
+        .withParameter("hdma.direction", DMA_PERIPH_TO_MEMORY)
+        .ignoreOtherParameters();
+
+    [[maybe_unused]] SpiDma engine{writer, eth::spi::spi2Dma};
+    CHECK_TRUE(writer.nativeHandle().hdmatx != nullptr);
+    CHECK_TRUE(writer.nativeHandle().hdmarx != nullptr);
+}
+
+TEST(SpiDmaTest, startWriteTransmitsFirstFrame)
+{
+    const std::array<std::uint8_t, 2> data{{0xab, 0xcd}};
+    const std::array<SpiDma::WriteSegment, 1> segments{{{0x4000, data}}};
+    expectFrame(std::array<std::uint8_t, 4>{{0xf0, 0x40, 0x00, 0xab}});
+
+    CHECK_TRUE(dma->startWrite(segments, onComplete, &completions));
+    CHECK_TRUE(dma->isBusy());
+    CHECK_EQUAL(0, completions);
+}
+
+TEST(SpiDmaTest, frameCompleteStartsNextFrame)
+{
+    const std::array<std::uint8_t, 2> data{{0xab, 0xcd}};
+    const std::array<SpiDma::WriteSegment, 1> segments{{{0x4000, data}}};
+    expectFrame(std::array<std::uint8_t, 4>{{0xf0, 0x40, 0x00, 0xab}});
+    expectInterrupt();
+    expectFrame(std::array<std::uint8_t, 4>{{0xf0, 0x40, 0x01, 0xcd}});
+
+    dma->startWrite(segments, onComplete, &completions);
+    dma->handleTransmitInterrupt();
+    CHECK_TRUE(dma->isBusy());
+    CHECK_EQUAL(0, completions);
+}
+
+TEST(SpiDmaTest, lastFrameCompletesTransfer)
+{
+    const std::array<std::uint8_t, 1> data{{0xab}};
+    const std::array<SpiDma::WriteSegment, 1> segments{{{0x4000, data}}};
+    expectFrame(std::array<std::uint8_t, 4>{{0xf0, 0x40, 0x00, 0xab}});
+    expectInterrupt();
+
+    dma->startWrite(segments, onComplete, &completions);
+    dma->handleTransmitInterrupt();
+    CHECK_FALSE(dma->isBusy());
+    CHECK_EQUAL(1, completions);
+    CHECK_TRUE(lastResult);
+}
+
+TEST(SpiDmaTest, segmentsAreTransferredInOrder)
+{
+    const std::array<std::uint8_t, 2> data{{0x01, 0x02}};
+    const std::array<SpiDma::WriteSegment, 2> segments{{{0x47ff, std::span{data}.first(1)}, {0x4000, std::span{data}.subspan(1)}}};
+    expectFrame(std::array<std::uint8_t, 4>{{0xf0, 0x47, 0xff, 0x01}});
+    expectInterrupt();
+    expectFrame(std::array<std::uint8_t, 4>{{0xf0, 0x40, 0x00, 0x02}});
+    expectInterrupt();
+
+    dma->startWrite(segments, onComplete, &completions);
+    dma->handleTransmitInterrupt();
+    dma->handleTransmitInterrupt();
+    CHECK_EQUAL(1, completions);
+}
+
+TEST(SpiDmaTest, startReadCapturesReceivedBytes)
+{
+    std::array<std::uint8_t, 1> buffer{};
+    const std::array<SpiDma::ReadSegment, 1> segments{{{0x6010, buffer}}};
+    expectSlaveSelect(GPIO_PIN_RESET);
+    expectTransmitReceive(std::array<std::uint8_t, 4>{{0x0f, 0x60, 0x10, 0x00}}, std::array<std::uint8_t, 4>{{0x00, 0x01, 0x02, 0x77}});
+    mock("HAL_DMA").expectOneCall("HAL_DMA_IRQHandler").ignoreOtherParameters();
+    expectSlaveSelect(GPIO_PIN_SET);
+
+    dma->startRead(segments, onComplete, &completions);
+    dma->handleReceiveInterrupt();
+    CHECK_EQUAL(0x77, buffer[0]);
+    CHECK_EQUAL(1, completions);
+}
+
+TEST(SpiDmaTest, startFailsIfBusy)
+{
+    const std::array<std::uint8_t, 2> data{{0xab, 0xcd}};
+    const std::array<SpiDma::WriteSegment, 1> segments{{{0x4000, data}}};
+    mock().disable();
+    dma->startWrite(segments, onComplete, &completions);
+    mock().enable();
+
+    CHECK_FALSE(dma->startWrite(segments, onComplete, &completions));
+}
+
+TEST(SpiDmaTest, emptyTransferCompletesImmediately)
+{
+    const std::array<SpiDma::WriteSegment, 1> segments{{{0x4000, {}}}};
+
+    CHECK_TRUE(dma->startWrite(segments, onComplete, &completions));
+    CHECK_FALSE(dma->isBusy());
+    CHECK_EQUAL(1, completions);
+}
+
+TEST(SpiDmaTest, completionOfOtherSpiIsIgnored)
+{
+    const std::array<std::uint8_t, 1> data{{0xab}};
+    const std::array<SpiDma::WriteSegment, 1> segments{{{0x4000, data}}};
+    SPI_HandleTypeDef otherSpi{};
+    expectFrame(std::array<std::uint8_t, 4>{{0xf0, 0x40, 0x00, 0xab}});
+
+    dma->startWrite(segments, onComplete, &completions);
+    dma->onComplete(&otherSpi);
+    dma->onError(&otherSpi);
+    CHECK_TRUE(dma->isBusy());
+    CHECK_EQUAL(0, completions);
+}
+
+TEST(SpiDmaTest, failedStartReleasesTransfer)
+{
+    const std::array<std::uint8_t, 2> data{{0xab, 0xcd}};
+    const std::array<SpiDma::WriteSegment, 1> segments{{{0x4000, data}}};
+    expectSlaveSelect(GPIO_PIN_RESET);
+    mock("HAL_SPI").expectOneCall("HAL_SPI_Transmit_DMA").ignoreOtherParameters().andReturnValue(static_cast<unsigned int>(HAL_BUSY));
+    expectSlaveSelect(GPIO_PIN_SET);
+
+    CHECK_TRUE(dma->startWrite(segments, onComplete, &completions));
+    CHECK_FALSE(dma->isBusy());
+    CHECK_EQUAL(1, completions);
+    CHECK_FALSE(lastResult);
+}
+
+TEST(SpiDmaTest, errorAbortsTransfer)
+{
+    const std::array<std::uint8_t, 2> data{{0xab, 0xcd}};
+    const std::array<SpiDma::WriteSegment, 1> segments{{{0x4000, data}}};
+    expectFrame(std::array<std::uint8_t, 4>{{0xf0, 0x40, 0x00, 0xab}});
+    expectSlaveSelect(GPIO_PIN_SET);
+
+    dma->startWrite(segments, onComplete, &completions);
+    dma->onError(&spiWriter->nativeHandle());
+    CHECK_FALSE(dma->isBusy());
+    CHECK_EQUAL(1, completions);
+    CHECK_FALSE(lastResult);
+
+    expectFrame(std::array<std::uint8_t, 4>{{0xf0, 0x40, 0x00, 0xab}});
+    CHECK_TRUE(dma->startWrite(segments, onComplete, &completions));
+}
@@ -19,8 +19,10 @@
  */
 
 #include "spi/SpiWriter.h"
+#include "Byte.h"
 #include "mock/Stm32HalComparator.h"
 #include <memory>
+#include <vector>
 #include <span>
 #include <CppUTest/TestHarness.h>
 #include <CppUTestExt/MockSupport.h>
@@ -56,14 +58,14 @@ TEST_GROUP(SpiWriterTest)
             .withParameter("Timeout", timeout);
     }
 
-    void expectRead(const std::uint8_t* data) const
+    void expectTransfer(std::span<std::uint8_t> frame, std::span<const std::uint8_t> response) const
     {
-        constexpr auto size = sizeof(std::uint8_t);
         mock("HAL_SPI")
-            .expectOneCall("HAL_SPI_Receive")
+            .expectOneCall("HAL_SPI_TransmitReceive")
             .withPointerParameter("hspi", &spiWriter->nativeHandle())
-            .withOutputParameterReturning("pData", data, size)
-            .withParameter("Size", size)
+            .withMemoryBufferParameter("pTxData", frame.data(), frame.size())
+            .withOutputParameterReturning("pRxData", response.data(), response.size())
+            .withParameter("Size", frame.size())
             .withParameter("Timeout", timeout);
     }
 
@@ -147,13 +149,126 @@ TEST(SpiWriterTest, writeTransmitsByte)
 
 TEST(SpiWriterTest, readReceivesByte)
 {
-    const std::uint8_t value{0xcd};
-    std::array<std::uint8_t, 3> data{{0x0f, 0x33, 0x55}};
+    const std::array<std::uint8_t, 4> response{{0x01, 0x02, 0x03, 0xcd}};
+    std::array<std::uint8_t, 4> data{{0x0f, 0x33, 0x55, 0x00}};
     expectSlaveSelectSet();
-    expectWrite(data);
-    expectRead(&value);
+    expectTransfer(data, response);
     expectSlaveSelectReset();
 
     const auto result = spiWriter->read(0x3355);
-    CHECK_EQUAL(value, result);
+    CHECK_EQUAL(0xcd, result);
+}
+
+TEST(SpiWriterTest, writeBlockTransmitsFramePerByte)
+{
+    const std::array<std::uint8_t, 3> values{{0xab, 0xcd, 0xef}};
+    std::array<std::uint8_t, 4> frame0{{0xf0, 0x22, 0x11, 0xab}};
+    std::array<std::uint8_t, 4> frame1{{0xf0, 0x22, 0x12, 0xcd}};
+    std::array<std::uint8_t, 4> frame2{{0xf0, 0x22, 0x13, 0xef}};
+
+    for (auto& frame : {std::span{frame0}, std::span{frame1}, std::span{frame2}})
+    {
+        expectSlaveSelectSet();
+        expectWrite(frame);
+        expectSlaveSelectReset();
+    }
+
+    spiWriter->writeBlock(0x2211, values);
+}
+
+TEST(SpiWriterTest, writeBlockAcrossFrameBatches)
+{
+    constexpr std::size_t size{70};
+    const std::vector<std::uint8_t> values(size, 0x5a);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const std::uint16_t address = 0x40fe + i;
+        std::array<std::uint8_t, 4> frame{{0xf0, eth::byte::get<1>(address), eth::byte::get<0>(address), 0x5a}};
+        expectSlaveSelectSet();
+        expectWrite(frame);
+        expectSlaveSelectReset();
+    }
+
+    spiWriter->writeBlock(0x40fe, values);
+}
+
+TEST(SpiWriterTest, readBlockReceivesFramePerByte)
+{
+    const std::array<std::uint8_t, 4> response0{{0x01, 0x02, 0x03, 0x12}};
+    const std::array<std::uint8_t, 4> response1{{0x01, 0x02, 0x03, 0x34}};
+    std::array<std::uint8_t, 4> frame0{{0x0f, 0x33, 0x55, 0x00}};
+    std::array<std::uint8_t, 4> frame1{{0x0f, 0x33, 0x56, 0x00}};
+
+    expectSlaveSelectSet();
+    expectTransfer(frame0, response0);
+    expectSlaveSelectReset();
+    expectSlaveSelectSet();
+    expectTransfer(frame1, response1);
+    expectSlaveSelectReset();
+
+    std::array<std::uint8_t, 2> buffer{};
+    spiWriter->readBlock(0x3355, buffer);
+    CHECK_EQUAL(0x12, buffer[0]);
+    CHECK_EQUAL(0x34, buffer[1]);
+}
+
+TEST(SpiWriterTest, readBlockAcrossFrameBatches)
+{
+    constexpr std::size_t size{40};
+    const std::array<std::uint8_t, 4> response{{0x00, 0x00, 0x00, 0xa5}};
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const std::uint16_t address = 0x60fe + i;
+        std::array<std::uint8_t, 4> frame{{0x0f, eth::byte::get<1>(address), eth::byte::get<0>(address), 0x00}};
+        expectSlaveSelectSet();
+        expectTransfer(frame, response);
+        expectSlaveSelectReset();
+    }
+
+    std::vector<std::uint8_t> buffer(size, 0x00);
+    spiWriter->readBlock(0x60fe, buffer);
+    CHECK_TRUE(std::vector<std::uint8_t>(size, 0xa5) == buffer);
+}
+
+TEST(SpiWriterTest, writeFrameTransmitsHeaderAndDataInOneSelect)
+{
+    std::array<std::uint8_t, 3> header{{0x00, 0x24, 0x16}};
+    std::array<std::uint8_t, 3> data{{0xab, 0xcd, 0xef}};
+    expectSlaveSelectSet();
+    expectWrite(header);
+    expectWrite(data);
+    expectSlaveSelectReset();
+
+    spiWriter->writeFrame(header, data);
+}
+
+TEST(SpiWriterTest, writeFrameWithoutDataTransmitsHeaderOnly)
+{
+    std::array<std::uint8_t, 3> header{{0x00, 0x24, 0x16}};
+    expectSlaveSelectSet();
+    expectWrite(header);
+    expectSlaveSelectReset();
+
+    spiWriter->writeFrame(header, {});
+}
+
+TEST(SpiWriterTest, readFrameReceivesDataInOneSelect)
+{
+    const std::array<std::uint8_t, 3> values{{0x12, 0x34, 0x56}};
+    std::array<std::uint8_t, 3> header{{0x00, 0x28, 0x1b}};
+    expectSlaveSelectSet();
+    expectWrite(header);
+    mock("HAL_SPI")
+        .expectOneCall("HAL_SPI_Receive")
+        .withPointerParameter("hspi", &spiWriter->nativeHandle())
+        .withOutputParameterReturning("pData", values.data(), values.size())
+        .withParameter("Size", values.size())
+        .withParameter("Timeout", timeout);
+    expectSlaveSelectReset();
+
+    std::array<std::uint8_t, 3> buffer{};
+    spiWriter->readFrame(header, buffer);
+    MEMCMP_EQUAL(values.data(), buffer.data(), values.size());
 }
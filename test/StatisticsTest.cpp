@@ -0,0 +1,156 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Statistics.h"
+#include "Socket.h"
+#include "w5100/Device.h"
+#include "spi/SpiWriter.h"
+#include "sim/W5100Simulator.h"
+#include "TestHelper.h"
+#include <vector>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::Socket;
+using eth::SocketCommand;
+using eth::SocketHandle;
+using eth::w5100::BasicDevice;
+
+
+namespace
+{
+    constexpr inline SocketHandle socketHandle = eth::makeHandle<2>();
+
+    class ScriptedTransport
+    {
+    public:
+        void write([[maybe_unused]] std::uint16_t address, [[maybe_unused]] std::uint8_t data)
+        {
+        }
+
+        std::uint8_t read([[maybe_unused]] std::uint16_t address)
+        {
+            return (position < values.size()) ? values[position++] : 0;
+        }
+
+        void writeBlock([[maybe_unused]] std::uint16_t address, [[maybe_unused]] std::span<const std::uint8_t> data)
+        {
+        }
+
+        void readBlock([[maybe_unused]] std::uint16_t address, [[maybe_unused]] std::span<std::uint8_t> data)
+        {
+        }
+
+
+        std::vector<std::uint8_t> values;
+        std::size_t position{0};
+    };
+
+    static_assert(eth::stats::enabled);
+}
+
+
+TEST_GROUP(StatisticsTest)
+{
+    void setup() override
+    {
+        mock("platform").ignoreOtherCalls();
+        eth::stats::reset();
+    }
+
+    void teardown() override
+    {
+        mock().clear();
+    }
+};
+
+TEST(StatisticsTest, socketCountsBytesAndCommands)
+{
+    eth::sim::W5100Simulator simulator;
+    BasicDevice<eth::sim::W5100Simulator> device{simulator};
+    Socket socket{socketHandle, device};
+    socket.open(eth::Protocol::tcp, 5000, 0);
+    socket.connect({{192, 168, 0, 5}}, 6000);
+
+    const auto data = createBuffer(100);
+    std::vector<std::uint8_t> buffer(40);
+    socket.send(data);
+    simulator.injectReceive(socketHandle, buffer);
+    socket.receive(buffer);
+
+    const auto snapshot = eth::stats::snapshot();
+    CHECK_EQUAL(100, snapshot.sockets[socketHandle.value()].bytesSent);
+    CHECK_EQUAL(1, snapshot.sockets[socketHandle.value()].sendCommands);
+    CHECK_EQUAL(40, snapshot.sockets[socketHandle.value()].bytesReceived);
+    CHECK_EQUAL(1, snapshot.sockets[socketHandle.value()].receiveCommands);
+    CHECK_EQUAL(0, snapshot.socketWaitIterations);
+    CHECK_EQUAL(0, snapshot.sockets[0].bytesSent);
+}
+
+TEST(StatisticsTest, socketCountsOnlyActualWaits)
+{
+    ScriptedTransport transport;
+    BasicDevice<ScriptedTransport> device{transport};
+    Socket socket{socketHandle, device};
+    transport.values = {0x17, 0x00, 0x00, 0x17, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00};
+
+    const auto data = createBuffer(1);
+    CHECK_EQUAL(1, socket.send(data));
+    CHECK_EQUAL(1, eth::stats::snapshot().socketWaitIterations);
+}
+
+TEST(StatisticsTest, deviceCountsCommandWaitAndFreeSizeRetries)
+{
+    ScriptedTransport transport;
+    BasicDevice<ScriptedTransport> device{transport};
+    transport.values = {0x20, 0x20, 0x00, 0x01, 0x00, 0x02, 0x00, 0x02, 0x00, 0x02, 0x00};
+
+    device.executeSocketCommand(socketHandle, SocketCommand::send);
+    CHECK_EQUAL(0x0200, device.getTransmitFreeSize(socketHandle));
+
+    const auto snapshot = eth::stats::snapshot();
+    CHECK_EQUAL(2, snapshot.commandWaitIterations);
+    CHECK_EQUAL(1, snapshot.freeSizeRetries);
+}
+
+TEST(StatisticsTest, spiWriterCountsFrames)
+{
+    mock().disable();
+    eth::spi::SpiWriter writer{eth::spi::spi2};
+    std::array<std::uint8_t, 3> buffer{};
+
+    writer.write(0x0400, 0x01);
+    writer.readBlock(0x6000, buffer);
+    mock().enable();
+
+    CHECK_EQUAL(4, eth::stats::snapshot().spiFrames);
+}
+
+TEST(StatisticsTest, resetClearsCounters)
+{
+    eth::stats::countSend(socketHandle, 10);
+    eth::stats::countSpiFrames(5);
+
+    eth::stats::reset();
+
+    const auto snapshot = eth::stats::snapshot();
+    CHECK_EQUAL(0, snapshot.sockets[socketHandle.value()].bytesSent);
+    CHECK_EQUAL(0, snapshot.spiFrames);
+}
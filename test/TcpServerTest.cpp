@@ -0,0 +1,157 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TcpServer.h"
+#include "sim/W5100Simulator.h"
+#include "w5100/Device.h"
+#include "TestHelper.h"
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::Socket;
+using eth::SocketHandle;
+using eth::SocketStatus;
+using eth::TcpServer;
+using eth::sim::W5100Simulator;
+
+
+namespace
+{
+    constexpr std::uint16_t port{5000};
+}
+
+
+TEST_GROUP(TcpServerTest)
+{
+    void setup() override
+    {
+        mock("platform").ignoreOtherCalls();
+    }
+
+    void teardown() override
+    {
+        mock().clear();
+    }
+
+
+    W5100Simulator simulator;
+    eth::w5100::BasicDevice<W5100Simulator> device{simulator};
+};
+
+TEST(TcpServerTest, backlogLimitedBySocketCount)
+{
+    TcpServer server{device, port, 8};
+    CHECK_EQUAL(eth::supportedSockets, server.backlog());
+}
+
+TEST(TcpServerTest, listenOpensAllSocketsOfBacklog)
+{
+    TcpServer server{device, port, 3};
+    CHECK_EQUAL(Socket::Status::ok, server.listen());
+
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(eth::makeHandle<0>()));
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(eth::makeHandle<1>()));
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(eth::makeHandle<2>()));
+    CHECK_EQUAL(SocketStatus::closed, simulator.status(eth::makeHandle<3>()));
+}
+
+TEST(TcpServerTest, acceptReturnsNothingWithoutClients)
+{
+    TcpServer server{device, port};
+    server.listen();
+
+    CHECK_TRUE(server.accept() == nullptr);
+    CHECK_EQUAL(0, server.connections());
+}
+
+TEST(TcpServerTest, acceptHandsOutEachConnectionOnce)
+{
+    TcpServer server{device, port};
+    server.listen();
+    simulator.acceptConnection(eth::makeHandle<2>());
+
+    auto* socket = server.accept();
+    CHECK_TRUE(socket != nullptr);
+    CHECK_EQUAL(SocketStatus::established, socket->getStatus());
+    CHECK_TRUE(server.accept() == nullptr);
+    CHECK_EQUAL(1, server.connections());
+}
+
+TEST(TcpServerTest, acceptsConcurrentClients)
+{
+    TcpServer server{device, port};
+    server.listen();
+    simulator.acceptConnection(eth::makeHandle<0>());
+    simulator.acceptConnection(eth::makeHandle<1>());
+    simulator.acceptConnection(eth::makeHandle<3>());
+
+    auto* first = server.accept();
+    auto* second = server.accept();
+    auto* third = server.accept();
+
+    CHECK_TRUE(first != nullptr);
+    CHECK_TRUE(second != nullptr);
+    CHECK_TRUE(third != nullptr);
+    CHECK_TRUE(first != second);
+    CHECK_TRUE(second != third);
+    CHECK_TRUE(server.accept() == nullptr);
+    CHECK_EQUAL(3, server.connections());
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(eth::makeHandle<2>()));
+}
+
+TEST(TcpServerTest, releaseRearmsSocket)
+{
+    TcpServer server{device, port};
+    server.listen();
+    simulator.acceptConnection(eth::makeHandle<1>());
+    auto* socket = server.accept();
+    simulator.closeByPeer(eth::makeHandle<1>());
+
+    server.release(*socket);
+
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(eth::makeHandle<1>()));
+    CHECK_EQUAL(0, server.connections());
+
+    simulator.acceptConnection(eth::makeHandle<1>());
+    CHECK_TRUE(server.accept() == socket);
+}
+
+TEST(TcpServerTest, acceptRearmsClosedIdleSocket)
+{
+    TcpServer server{device, port, 1};
+    server.listen();
+    Socket other{eth::makeHandle<0>(), device};
+    other.close();
+
+    CHECK_TRUE(server.accept() == nullptr);
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(eth::makeHandle<0>()));
+}
+
+TEST(TcpServerTest, activeSocketNotRearmedBeforeRelease)
+{
+    TcpServer server{device, port};
+    server.listen();
+    simulator.acceptConnection(eth::makeHandle<0>());
+    server.accept();
+    simulator.closeByPeer(eth::makeHandle<0>());
+
+    CHECK_TRUE(server.accept() == nullptr);
+    CHECK_EQUAL(SocketStatus::closeWait, simulator.status(eth::makeHandle<0>()));
+}
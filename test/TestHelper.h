@@ -37,6 +37,11 @@ inline SimpleString StringFrom(eth::SocketCommand cmd)
     return SimpleString("0x") + HexStringFrom(static_cast<unsigned long>(cmd));
 }
 
+inline SimpleString StringFrom(eth::Protocol protocol)
+{
+    return SimpleString("0x") + HexStringFrom(static_cast<unsigned long>(protocol));
+}
+
 inline SimpleString StringFrom(eth::Socket::Status status)
 {
     using eth::Socket;
@@ -51,6 +56,8 @@ inline SimpleString StringFrom(eth::Socket::Status status)
             return "closed";
         case Socket::Status::timeout:
             return "timeout";
+        case Socket::Status::wouldBlock:
+            return "wouldBlock";
         default:
             return "UNKNOWN";
     }
@@ -0,0 +1,121 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Trace.h"
+#include "Socket.h"
+#include "w5100/Device.h"
+#include "spi/RegisterTransport.h"
+#include "sim/W5100Simulator.h"
+#include "sim/FakeSpiPeripheral.h"
+#include "TestHelper.h"
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::trace::Probe;
+
+
+namespace
+{
+    static_assert(eth::trace::enabled);
+}
+
+
+TEST_GROUP(TraceTest)
+{
+    void setup() override
+    {
+        eth::trace::reset();
+    }
+
+    void teardown() override
+    {
+        mock().checkExpectations();
+        mock().clear();
+    }
+};
+
+TEST(TraceTest, bucketIsLog2OfCycles)
+{
+    CHECK_EQUAL(0, eth::trace::bucketOf(0));
+    CHECK_EQUAL(1, eth::trace::bucketOf(1));
+    CHECK_EQUAL(2, eth::trace::bucketOf(3));
+    CHECK_EQUAL(10, eth::trace::bucketOf(1000));
+    CHECK_EQUAL(32, eth::trace::bucketOf(0xffffffff));
+}
+
+TEST(TraceTest, recordTracksSamplesMaxAndTotal)
+{
+    eth::trace::record(Probe::spiTransfer, 40);
+    eth::trace::record(Probe::spiTransfer, 48);
+    eth::trace::record(Probe::spiTransfer, 5000);
+
+    const auto histogram = eth::trace::histogram(Probe::spiTransfer);
+    CHECK_EQUAL(3, histogram.samples);
+    CHECK_EQUAL(2, histogram.buckets[6]);
+    CHECK_EQUAL(1, histogram.buckets[13]);
+    CHECK_EQUAL(5000, histogram.max);
+    CHECK_EQUAL(5088, histogram.total);
+    CHECK_EQUAL(0, eth::trace::histogram(Probe::socketSend).samples);
+}
+
+TEST(TraceTest, scopeRecordsElapsedCycles)
+{
+    {
+        const eth::trace::Scope scope{Probe::executeCommand};
+    }
+
+    const auto histogram = eth::trace::histogram(Probe::executeCommand);
+    CHECK_EQUAL(1, histogram.samples);
+    CHECK_EQUAL(histogram.max, histogram.total);
+    CHECK_EQUAL(1, histogram.buckets[eth::trace::bucketOf(histogram.max)]);
+}
+
+TEST(TraceTest, socketAndDeviceOperationsAreTraced)
+{
+    mock("platform").ignoreOtherCalls();
+    eth::sim::W5100Simulator simulator;
+    eth::w5100::BasicDevice<eth::sim::W5100Simulator> device{simulator};
+    eth::Socket socket{eth::makeHandle<0>(), device};
+    socket.open(eth::Protocol::tcp, 5000, 0);
+    socket.connect({{192, 168, 0, 5}}, 6000);
+    eth::trace::reset();
+
+    const auto data = createBuffer(10);
+    socket.send(data);
+
+    CHECK_EQUAL(1, eth::trace::histogram(Probe::socketSend).samples);
+    CHECK_EQUAL(1, eth::trace::histogram(Probe::executeCommand).samples);
+    CHECK_EQUAL(0, eth::trace::histogram(Probe::socketReceive).samples);
+}
+
+TEST(TraceTest, blockTransfersHaveOwnProbe)
+{
+    mock("platform").ignoreOtherCalls();
+    eth::sim::W5100Simulator simulator;
+    eth::sim::FakeSpiPeripheral peripheral{simulator, GPIO_PIN_12};
+    eth::spi::BasicRegisterTransport<eth::sim::FakeSpiPeripheral::SpiRegisters, eth::sim::FakeSpiPeripheral::GpioRegisters> transport{peripheral.spi, peripheral.gpio, GPIO_PIN_12};
+    const auto data = createBuffer(10);
+
+    transport.write(0x0001, 0xc0);
+    transport.writeBlock(0x0001, data);
+
+    CHECK_EQUAL(1, eth::trace::histogram(Probe::spiTransfer).samples);
+    CHECK_EQUAL(1, eth::trace::histogram(Probe::spiBlockTransfer).samples);
+}
@@ -0,0 +1,270 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "UdpSocket.h"
+#include "SocketStatus.h"
+#include "SocketCommand.h"
+#include "Protocol.h"
+#include "mock/NetDeviceMock.h"
+#include "TestHelper.h"
+#include <array>
+#include <memory>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::NetAddress;
+using eth::Protocol;
+using eth::SocketCommand;
+using eth::SocketHandle;
+using eth::SocketStatus;
+using eth::UdpSocket;
+using eth::test::NetDeviceMock;
+
+
+namespace
+{
+    inline constexpr SocketHandle socketHandle = eth::makeHandle<1>();
+}
+
+
+TEST_GROUP(UdpSocketTest)
+{
+    void setup() override
+    {
+        socket = std::make_unique<UdpSocket>(socketHandle, device);
+        mock().strictOrder();
+    }
+
+    void teardown() override
+    {
+        mock().disable();
+        socket.reset();
+        mock().enable();
+        mock().checkExpectations();
+        mock().clear();
+    }
+
+    void expectSocketCommand(SocketCommand cmd) const
+    {
+        mock("Device")
+            .expectOneCall("executeSocketCommand")
+            .withParameter("socket", socketHandle.value())
+            .withParameter("value", static_cast<std::uint8_t>(cmd));
+    }
+
+    void expectSocketStatusRead(SocketStatus status) const
+    {
+        mock("Device")
+            .expectOneCall("readSocketStatusRegister")
+            .withParameter("socket", socketHandle.value())
+            .andReturnValue(static_cast<std::uint8_t>(status));
+    }
+
+    void expectSocketInterruptRead(std::uint8_t value) const
+    {
+        mock("Device").expectOneCall("readSocketInterruptRegister").withParameter("socket", socketHandle.value()).andReturnValue(value);
+    }
+
+    void expectSocketInterruptWrite(std::uint8_t value) const
+    {
+        mock("Device")
+            .expectOneCall("writeSocketInterruptRegister")
+            .withParameter("socket", socketHandle.value())
+            .withParameter("value", value);
+    }
+
+    void expectReceiveSize(std::uint16_t size) const
+    {
+        mock("Device").expectOneCall("getReceiveFreeSize").withParameter("socket", socketHandle.value()).andReturnValue(size);
+    }
+
+    void expectReadPointer(std::uint16_t value) const
+    {
+        mock("Device").expectOneCall("readReceivePointer").withParameter("socket", socketHandle.value()).andReturnValue(value);
+    }
+
+    template <class Container>
+    void expectReadBuffer(std::uint16_t pointer, const Container& data) const
+    {
+        mock("Device")
+            .expectOneCall("readReceiveBuffer")
+            .withParameter("socket", socketHandle.value())
+            .withParameter("pointer", pointer)
+            .withOutputParameterReturning("buffer", data.data(), data.size())
+            .withParameter("size", data.size());
+    }
+
+    void expectHeaderRead(std::uint16_t pointer, std::uint16_t size) const
+    {
+        const std::array<std::uint8_t, 8> header{{192, 168, 1, 5, 0x12, 0x34, static_cast<std::uint8_t>(size >> 8), static_cast<std::uint8_t>(size)}};
+        expectReadBuffer(pointer, header);
+    }
+
+    void expectReceiveDone(std::uint16_t pointer) const
+    {
+        mock("Device").expectOneCall("writeReceivePointer").withParameter("socket", socketHandle.value()).withParameter("value", pointer);
+        expectSocketCommand(SocketCommand::receive);
+    }
+
+
+    NetDeviceMock device;
+    std::unique_ptr<UdpSocket> socket;
+};
+
+TEST(UdpSocketTest, openOpensUdpSocket)
+{
+    expectSocketCommand(SocketCommand::close);
+    expectSocketInterruptWrite(0xff);
+    expectSocketStatusRead(SocketStatus::closed);
+    mock("Device")
+        .expectOneCall("writeSocketModeRegister")
+        .withParameter("socket", socketHandle.value())
+        .withParameter("value", static_cast<std::uint8_t>(Protocol::udp));
+    mock("Device").expectOneCall("writeSocketSourcePort").withParameter("socket", socketHandle.value()).withParameter("value", 5000);
+    expectSocketCommand(SocketCommand::open);
+    expectSocketStatusRead(SocketStatus::udp);
+
+    CHECK_EQUAL(UdpSocket::Status::ok, socket->open(5000));
+}
+
+TEST(UdpSocketTest, openFailsIfNotInUdpState)
+{
+    mock("Device").expectOneCall("executeSocketCommand").ignoreOtherParameters();
+    mock("Device").expectOneCall("writeSocketInterruptRegister").ignoreOtherParameters();
+    expectSocketStatusRead(SocketStatus::closed);
+    mock("Device").expectOneCall("writeSocketModeRegister").ignoreOtherParameters();
+    mock("Device").expectOneCall("writeSocketSourcePort").ignoreOtherParameters();
+    expectSocketCommand(SocketCommand::open);
+    expectSocketStatusRead(SocketStatus::closed);
+
+    CHECK_EQUAL(UdpSocket::Status::failed, socket->open(5000));
+}
+
+TEST(UdpSocketTest, sendToSendsDatagram)
+{
+    const NetAddress<4> addr{{192, 168, 1, 5}};
+    const auto buffer = createBuffer(10);
+    mock("Device").expectOneCall("getTransmitFreeSize").withParameter("socket", socketHandle.value()).andReturnValue(2048);
+    mock("Device")
+        .expectOneCall("setDestAddress")
+        .withParameter("socket", socketHandle.value())
+        .withMemoryBufferParameter("buffer", addr.data(), addr.size())
+        .withParameter("port", 7000);
+    mock("Device").expectOneCall("sendData").withParameter("socket", socketHandle.value()).withParameter("size", buffer.size()).ignoreOtherParameters();
+    expectSocketCommand(SocketCommand::send);
+    expectSocketInterruptRead(0x00);
+    expectSocketInterruptRead(0x10);
+    expectSocketInterruptWrite(0x18);
+
+    CHECK_EQUAL(buffer.size(), socket->sendTo(addr, 7000, buffer));
+}
+
+TEST(UdpSocketTest, sendToWaitsForFreeSize)
+{
+    const auto buffer = createBuffer(10);
+    mock("Device").expectOneCall("getTransmitFreeSize").withParameter("socket", socketHandle.value()).andReturnValue(4);
+    expectSocketStatusRead(SocketStatus::udp);
+    mock("Device").expectOneCall("getTransmitFreeSize").withParameter("socket", socketHandle.value()).andReturnValue(10);
+    mock("Device").expectOneCall("setDestAddress").ignoreOtherParameters();
+    mock("Device").expectOneCall("sendData").ignoreOtherParameters();
+    expectSocketCommand(SocketCommand::send);
+    expectSocketInterruptRead(0x10);
+    expectSocketInterruptWrite(0x18);
+
+    CHECK_EQUAL(buffer.size(), socket->sendTo({{192, 168, 1, 5}}, 7000, buffer));
+}
+
+TEST(UdpSocketTest, sendToReturnsZeroOnTimeout)
+{
+    const auto buffer = createBuffer(10);
+    mock("Device").expectOneCall("getTransmitFreeSize").withParameter("socket", socketHandle.value()).andReturnValue(2048);
+    mock("Device").expectOneCall("setDestAddress").ignoreOtherParameters();
+    mock("Device").expectOneCall("sendData").ignoreOtherParameters();
+    expectSocketCommand(SocketCommand::send);
+    expectSocketInterruptRead(0x08);
+    expectSocketInterruptWrite(0x18);
+
+    CHECK_EQUAL(0, socket->sendTo({{192, 168, 1, 5}}, 7000, buffer));
+}
+
+TEST(UdpSocketTest, sendToRejectsOversizedDatagram)
+{
+    const auto buffer = createBuffer(2049);
+    CHECK_EQUAL(0, socket->sendTo({{192, 168, 1, 5}}, 7000, buffer));
+}
+
+TEST(UdpSocketTest, receiveFromWouldBlockWithoutData)
+{
+    expectReceiveSize(0);
+
+    std::array<std::uint8_t, 16> buffer{};
+    const auto result = socket->receiveFrom(buffer);
+    CHECK_EQUAL(UdpSocket::Status::wouldBlock, result.status);
+}
+
+TEST(UdpSocketTest, receiveFromParsesHeader)
+{
+    const auto payload = createBuffer(5);
+    expectReceiveSize(13);
+    expectReadPointer(0x0100);
+    expectHeaderRead(0x0100, 5);
+    expectReadBuffer(0x0108, payload);
+    expectReceiveDone(0x010d);
+
+    std::array<std::uint8_t, 16> buffer{};
+    const auto result = socket->receiveFrom(buffer);
+    CHECK_EQUAL(UdpSocket::Status::ok, result.status);
+    CHECK_EQUAL(5, result.size);
+    CHECK_EQUAL(0x1234, result.port);
+    CHECK_TRUE((result.address == NetAddress<4>{{192, 168, 1, 5}}));
+    CHECK_TRUE(std::equal(payload.begin(), payload.end(), buffer.begin()));
+}
+
+TEST(UdpSocketTest, receiveFromDrainsQueuedDatagramsWithSingleReceiveCommand)
+{
+    const auto first = createBuffer(4);
+    const auto second = createBuffer(6);
+    expectReceiveSize(26);
+    expectReadPointer(0x07f0);
+    expectHeaderRead(0x07f0, 4);
+    expectReadBuffer(0x07f8, first);
+    expectHeaderRead(0x07fc, 6);
+    expectReadBuffer(0x0804, second);
+    expectReceiveDone(0x080a);
+
+    std::array<std::uint8_t, 16> buffer{};
+    CHECK_EQUAL(4, socket->receiveFrom(buffer).size);
+    CHECK_EQUAL(6, socket->receiveFrom(buffer).size);
+}
+
+TEST(UdpSocketTest, receiveFromTruncatesToBuffer)
+{
+    const auto payload = createBuffer(4);
+    expectReceiveSize(18);
+    expectReadPointer(0x0000);
+    expectHeaderRead(0x0000, 10);
+    expectReadBuffer(0x0008, payload);
+    expectReceiveDone(0x0012);
+
+    std::array<std::uint8_t, 4> buffer{};
+    const auto result = socket->receiveFrom(buffer);
+    CHECK_EQUAL(UdpSocket::Status::ok, result.status);
+    CHECK_EQUAL(4, result.size);
+}
@@ -20,6 +20,7 @@
 
 #include "w5100/Device.h"
 #include "spi/SpiWriter.h"
+#include "spi/SpiDma.h"
 #include "Byte.h"
 #include "TestHelper.h"
 #include <vector>
@@ -33,8 +34,10 @@ using eth::SocketCommand;
 using eth::SocketHandle;
 using eth::SocketInterrupt;
 using eth::SocketStatus;
+using eth::spi::SpiDma;
 using eth::spi::SpiWriter;
 using eth::w5100::Device;
+using eth::w5100::MemoryLayout;
 using eth::w5100::makeRegister;
 using eth::w5100::Register;
 
@@ -42,6 +45,20 @@ using eth::w5100::Register;
 namespace
 {
     constexpr inline SocketHandle socketHandle = eth::makeHandle<0>();
+
+
+    struct TransferResult
+    {
+        int calls;
+        bool success;
+    };
+
+    void recordTransfer(void* context, bool success)
+    {
+        auto& result = *static_cast<TransferResult*>(context);
+        ++result.calls;
+        result.success = success;
+    }
 }
 
 
@@ -53,7 +70,6 @@ TEST_GROUP(W5100DeviceTest)
         mock().disable();
         device = std::make_unique<Device>(writer);
         mock().enable();
-        mock("SpiWriter").setData("write::count", 0);
     }
 
     void teardown() override
@@ -74,40 +90,54 @@ TEST_GROUP(W5100DeviceTest)
     }
 
     template <class Container>
-    void expectWrite(std::uint16_t addr, const Container& data) const
+    void expectWriteBlock(std::uint16_t addr, const Container& data) const
     {
-        std::for_each(data.begin(), data.end(), [this, &addr](std::uint8_t value)
-                      { expectWrite(addr++, value); });
+        mock("SpiWriter")
+            .expectOneCall("writeBlock")
+            .withParameter("address", addr)
+            .withMemoryBufferParameter("data", data.data(), data.size())
+            .withParameter("size", data.size());
     }
 
-    void checkWriteCalls(std::size_t expectedCalls) const
+    void expectRead(std::uint16_t addr, std::uint8_t data) const
     {
-        const auto actual = mock("SpiWriter").getData("write::count").getUnsignedIntValue();
-        CHECK_EQUAL(expectedCalls, actual);
+        mock("SpiWriter").expectOneCall("read").withParameter("address", addr).andReturnValue(data);
     }
 
-    void checkReadCalls(std::size_t expectedCalls) const
+    void expectRead(std::uint16_t addr, std::uint16_t data) const
     {
-        const auto actual = mock("SpiWriter").getData("read::count").getUnsignedIntValue();
-        CHECK_EQUAL(expectedCalls, actual);
+        expectRead(addr, eth::byte::get<1>(data));
+        expectRead(addr + 1, eth::byte::get<0>(data));
     }
 
-    void expectRead(std::uint16_t addr, std::uint8_t data) const
+    template <class Container>
+    void expectReadBlock(std::uint16_t addr, const Container& data) const
     {
-        mock("SpiWriter").expectOneCall("read").withParameter("address", addr).andReturnValue(data);
+        mock("SpiWriter")
+            .expectOneCall("readBlock")
+            .withParameter("address", addr)
+            .withOutputParameterReturning("data", data.data(), data.size())
+            .withParameter("size", data.size());
     }
 
-    void expectRead(std::uint16_t addr, std::uint16_t data) const
+    template <class Container>
+    void expectDmaWriteSegment(std::uint16_t addr, const Container& data) const
     {
-        expectRead(addr, eth::byte::get<1>(data));
-        expectRead(addr + 1, eth::byte::get<0>(data));
+        mock("SpiDma")
+            .expectOneCall("writeSegment")
+            .withParameter("address", addr)
+            .withMemoryBufferParameter("data", data.data(), data.size())
+            .withParameter("size", data.size());
     }
 
     template <class Container>
-    void expectRead(std::uint16_t addr, const Container& data) const
+    void expectDmaReadSegment(std::uint16_t addr, const Container& data) const
     {
-        std::for_each(data.begin(), data.end(), [this, &addr](std::uint8_t value)
-                      { expectRead(addr++, value); });
+        mock("SpiDma")
+            .expectOneCall("readSegment")
+            .withParameter("address", addr)
+            .withOutputParameterReturning("data", data.data(), data.size())
+            .withParameter("size", data.size());
     }
 
     static constexpr std::uint16_t toAddress(eth::SocketHandle s, std::uint16_t address)
@@ -118,6 +148,7 @@ TEST_GROUP(W5100DeviceTest)
 
     std::unique_ptr<Device> device;
     SpiWriter writer{eth::spi::spi2};
+    SpiDma dma{writer, eth::spi::spi2Dma};
 };
 
 TEST(W5100DeviceTest, initSetsResetBitAndMemorySize)
@@ -136,6 +167,19 @@ TEST(W5100DeviceTest, initSetsResetBitAndMemorySize)
     [[maybe_unused]] Device d{writer};
 }
 
+TEST(W5100DeviceTest, initSetsMemoryLayout)
+{
+    expectWrite(0x0000, std::uint8_t{0x80});
+    expectWrite(0x001b, std::uint8_t{0x03});
+    expectWrite(0x001a, std::uint8_t{0x06});
+
+    constexpr MemoryLayout layout{{{8, 0, 0, 0}}, {{4, 2, 1, 1}}};
+    const Device d{writer, layout};
+    CHECK_EQUAL(8192, d.getTransmitBufferSize(socketHandle));
+    CHECK_EQUAL(4096, d.getReceiveBufferSize(socketHandle));
+    CHECK_EQUAL(1024, d.getReceiveBufferSize(eth::makeHandle<3>()));
+}
+
 TEST(W5100DeviceTest, writeRegisterByte)
 {
     constexpr auto reg = makeRegister<std::uint8_t>(0xabcd);
@@ -161,7 +205,7 @@ TEST(W5100DeviceTest, writeSpan)
     std::span span{data};
     const auto reg = Register<decltype(span)>(0xa1b2);
 
-    expectWrite(0xa1b2, span);
+    expectWriteBlock(0xa1b2, span);
     device->write(reg, span.begin(), span.end());
 }
 
@@ -171,7 +215,7 @@ TEST(W5100DeviceTest, writeBuffer)
     const auto data = createBuffer(size);
     const auto reg = Register<decltype(data)>(0xa1b2);
 
-    expectWrite(reg.address(), data);
+    expectWriteBlock(reg.address(), data);
 
     device->write(reg, data.cbegin(), data.cend());
 }
@@ -182,7 +226,7 @@ TEST(W5100DeviceTest, writeBufferByPointerAndSize)
     const auto data = createBuffer(size);
     auto reg = Register<decltype(std::span{data})>(0xa1b2);
 
-    expectWrite(reg.address(), data);
+    expectWriteBlock(reg.address(), data);
 
     device->write(reg, data.data(), std::next(data.data(), size));
 }
@@ -211,7 +255,7 @@ TEST(W5100DeviceTest, readRegisterSpan)
 {
     constexpr std::uint16_t size{10};
     const auto data = createBuffer(size);
-    expectRead(0xddee, data);
+    expectReadBlock(0xddee, data);
 
     std::array<std::uint8_t, size> buffer{};
     const auto reg = Register<decltype(buffer)>(0xddee);
@@ -239,6 +283,40 @@ TEST(W5100DeviceTest, writeSocketSourcePort)
     device->writeSocketSourcePort(socketHandle, value);
 }
 
+TEST(W5100DeviceTest, writeSocketModeRegisterSuppressesRedundantWrite)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0000);
+    expectWrite(address, std::uint8_t{0x01});
+    expectWrite(address, std::uint8_t{0x02});
+
+    device->writeSocketModeRegister(socketHandle, 0x01);
+    device->writeSocketModeRegister(socketHandle, 0x01);
+    device->writeSocketModeRegister(socketHandle, 0x02);
+    CHECK_EQUAL(0x02, device->readSocketModeRegister(socketHandle));
+}
+
+TEST(W5100DeviceTest, readSocketSourcePortIsCached)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0004);
+    expectRead(address, std::uint16_t{0x1388});
+
+    CHECK_EQUAL(0x1388, device->readSocketSourcePort(socketHandle));
+    CHECK_EQUAL(0x1388, device->readSocketSourcePort(socketHandle));
+    device->writeSocketSourcePort(socketHandle, 0x1388);
+}
+
+TEST(W5100DeviceTest, resetInvalidatesShadowRegisters)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0004);
+    expectWrite(address, std::uint16_t{0x1388});
+    expectWrite(0x0000, static_cast<std::uint8_t>(Mode::reset));
+    expectWrite(address, std::uint16_t{0x1388});
+
+    device->writeSocketSourcePort(socketHandle, 0x1388);
+    device->writeModeRegister(Mode::reset);
+    device->writeSocketSourcePort(socketHandle, 0x1388);
+}
+
 TEST(W5100DeviceTest, writeSocketInterruptRegister)
 {
     constexpr std::uint16_t address = toAddress(socketHandle, 0x0002);
@@ -258,6 +336,25 @@ TEST(W5100DeviceTest, readSocketInterruptRegister)
     CHECK_EQUAL(value, rtn.value());
 }
 
+TEST(W5100DeviceTest, readInterruptRegister)
+{
+    constexpr std::uint16_t address{0x0015};
+    constexpr std::uint8_t value{0x05};
+    expectRead(address, value);
+
+    const auto rtn = device->readInterruptRegister();
+    CHECK_EQUAL(value, rtn);
+}
+
+TEST(W5100DeviceTest, writeInterruptMaskRegister)
+{
+    constexpr std::uint16_t address{0x0016};
+    constexpr std::uint8_t value{0x0f};
+    expectWrite(address, value);
+
+    device->writeInterruptMaskRegister(value);
+}
+
 TEST(W5100DeviceTest, writeSocketCommandRegister)
 {
     constexpr std::uint16_t address = toAddress(socketHandle, 0x0001);
@@ -290,6 +387,24 @@ TEST(W5100DeviceTest, executeSocketCommand)
     device->executeSocketCommand(socketHandle, cmd);
 }
 
+TEST(W5100DeviceTest, readSocketStateReadsRegisterBlocks)
+{
+    const std::array<std::uint8_t, 2> flags{{0x14, 0x17}};
+    const std::array<std::uint8_t, 10> pointers{{0x07, 0xf0, 0x12, 0x34, 0x12, 0x44, 0x00, 0x20, 0x56, 0x78}};
+    expectReadBlock(toAddress(socketHandle, 0x0002), flags);
+    expectReadBlock(toAddress(socketHandle, 0x0020), pointers);
+
+    const auto state = device->readSocketState(socketHandle);
+    CHECK_EQUAL(SocketStatus::established, state.status);
+    CHECK_TRUE(state.interrupt.test(SocketInterrupt::Mask::send));
+    CHECK_TRUE(state.interrupt.test(SocketInterrupt::Mask::receive));
+    CHECK_EQUAL(0x07f0, state.transmitFreeSize);
+    CHECK_EQUAL(0x1234, state.transmitReadPointer);
+    CHECK_EQUAL(0x1244, state.transmitWritePointer);
+    CHECK_EQUAL(0x0020, state.receivedSize);
+    CHECK_EQUAL(0x5678, state.receiveReadPointer);
+}
+
 TEST(W5100DeviceTest, readSocketStatusRegister)
 {
     constexpr std::uint16_t address = toAddress(socketHandle, 0x0003);
@@ -335,21 +450,116 @@ TEST(W5100DeviceTest, sendData)
     constexpr std::uint16_t destAddress{0x4355};
     constexpr std::uint16_t size{5};
     auto buffer = createBuffer(size);
-    expectWrite(destAddress, buffer);
+    expectWriteBlock(destAddress, buffer);
     expectWrite(address, std::uint16_t{value + size});
 
     device->sendData(socketHandle, buffer);
 }
 
-TEST(W5100DeviceTest, sendDataCircularBufferWrap)
+TEST(W5100DeviceTest, sendDataTracksWritePointerLocally)
 {
-    constexpr auto ptrWrites = sizeof(std::uint16_t);
-    const std::uint16_t size = Device::getRxTxBufferSize() + 2;
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0024);
+    constexpr std::uint16_t value{0x3355};
+    constexpr std::uint16_t size{5};
     auto buffer = createBuffer(size);
-    mock("SpiWriter").ignoreOtherCalls();
+    expectRead(address, value);
+    expectWriteBlock(0x4355, buffer);
+    expectWrite(address, std::uint16_t{value + size});
+    expectWriteBlock(0x4355 + size, buffer);
+    expectWrite(address, std::uint16_t{value + 2 * size});
 
     device->sendData(socketHandle, buffer);
-    checkWriteCalls(size + ptrWrites);
+    device->sendData(socketHandle, buffer);
+}
+
+TEST(W5100DeviceTest, openCommandResyncsPointers)
+{
+    constexpr std::uint16_t addressCommand = toAddress(socketHandle, 0x0001);
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0028);
+    expectRead(address, std::uint16_t{0x0010});
+    expectWrite(addressCommand, static_cast<std::uint8_t>(SocketCommand::open));
+    expectRead(addressCommand, std::uint8_t{0x00});
+    expectRead(address, std::uint16_t{0x0400});
+
+    CHECK_EQUAL(0x0010, device->readReceivePointer(socketHandle));
+    CHECK_EQUAL(0x0010, device->readReceivePointer(socketHandle));
+    device->executeSocketCommand(socketHandle, SocketCommand::open);
+    CHECK_EQUAL(0x0400, device->readReceivePointer(socketHandle));
+}
+
+TEST(W5100DeviceTest, connectionCommandsResyncPointers)
+{
+    constexpr std::uint16_t addressCommand = toAddress(socketHandle, 0x0001);
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0024);
+    expectRead(address, std::uint16_t{0x0010});
+    expectWrite(addressCommand, static_cast<std::uint8_t>(SocketCommand::listen));
+    expectRead(addressCommand, std::uint8_t{0x00});
+    expectRead(address, std::uint16_t{0x0800});
+    expectWrite(addressCommand, static_cast<std::uint8_t>(SocketCommand::connect));
+    expectRead(addressCommand, std::uint8_t{0x00});
+    expectRead(address, std::uint16_t{0x1000});
+
+    CHECK_EQUAL(0x0010, device->readTransmitPointer(socketHandle));
+    device->executeSocketCommand(socketHandle, SocketCommand::listen);
+    CHECK_EQUAL(0x0800, device->readTransmitPointer(socketHandle));
+    CHECK_EQUAL(0x0800, device->readTransmitPointer(socketHandle));
+    device->executeSocketCommand(socketHandle, SocketCommand::connect);
+    CHECK_EQUAL(0x1000, device->readTransmitPointer(socketHandle));
+}
+
+TEST(W5100DeviceTest, sendDataCircularBufferWrap)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0024);
+    constexpr std::uint16_t value{0x07fe};
+    expectRead(address, value);
+
+    constexpr std::uint16_t size{5};
+    const auto buffer = createBuffer(size);
+    const std::span data{buffer};
+    expectWriteBlock(0x47fe, data.first(2));
+    expectWriteBlock(0x4000, data.subspan(2));
+    expectWrite(address, std::uint16_t{value + size});
+
+    device->sendData(socketHandle, buffer);
+}
+
+TEST(W5100DeviceTest, sendDataCircularBufferWrapWithMemoryLayout)
+{
+    mock().disable();
+    Device d{writer, MemoryLayout{{{4, 2, 1, 1}}, {{2, 2, 2, 2}}}};
+    mock().enable();
+
+    constexpr auto handle = eth::makeHandle<2>();
+    constexpr std::uint16_t address = toAddress(handle, 0x0024);
+    constexpr std::uint16_t value{0x33fe};
+    expectRead(address, value);
+
+    constexpr std::uint16_t size{5};
+    const auto buffer = createBuffer(size);
+    const std::span data{buffer};
+    expectWriteBlock(0x5bfe, data.first(2));
+    expectWriteBlock(0x5800, data.subspan(2));
+    expectWrite(address, std::uint16_t{value + size});
+
+    d.sendData(handle, buffer);
+}
+
+TEST(W5100DeviceTest, sendDataSegmentsUpdatesPointerOnce)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0024);
+    constexpr std::uint16_t value{0x07fc};
+    expectRead(address, value);
+
+    const auto header = createBuffer(2);
+    const auto body = createBuffer(5);
+    const std::span bodyData{body};
+    expectWriteBlock(0x47fc, header);
+    expectWriteBlock(0x47fe, bodyData.first(2));
+    expectWriteBlock(0x4000, bodyData.subspan(2));
+    expectWrite(address, std::uint16_t{value + 7});
+
+    const std::array<std::span<const std::uint8_t>, 3> segments{{header, {}, body}};
+    device->sendData(socketHandle, segments);
 }
 
 TEST(W5100DeviceTest, receiveData)
@@ -361,7 +571,7 @@ TEST(W5100DeviceTest, receiveData)
     constexpr std::uint16_t destAddress{0x6355};
     constexpr std::uint16_t size{4};
     auto buffer = createBuffer(size);
-    expectRead(destAddress, buffer);
+    expectReadBlock(destAddress, buffer);
     expectWrite(address, std::uint16_t{value + size});
 
     std::array<std::uint8_t, size> data{};
@@ -372,14 +582,215 @@ TEST(W5100DeviceTest, receiveData)
 
 TEST(W5100DeviceTest, receiveDataCircularBufferWrap)
 {
-    constexpr auto ptrReads = sizeof(std::uint16_t);
-    constexpr std::uint16_t size = Device::getRxTxBufferSize() + 2;
-    mock("SpiWriter").ignoreOtherCalls();
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0028);
+    constexpr std::uint16_t value{0x07fe};
+    expectRead(address, value);
+
+    constexpr std::uint16_t size{5};
+    const auto buffer = createBuffer(size);
+    const std::span expected{buffer};
+    expectReadBlock(0x67fe, expected.first(2));
+    expectReadBlock(0x6000, expected.subspan(2));
+    expectWrite(address, std::uint16_t{value + size});
 
     std::array<std::uint8_t, size> data{};
     const auto rtn = device->receiveData(socketHandle, data);
     CHECK_EQUAL(size, rtn);
-    checkReadCalls(size + ptrReads);
+    CHECK_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin()));
+}
+
+TEST(W5100DeviceTest, receiveDataCircularBufferWrapWithMemoryLayout)
+{
+    mock().disable();
+    Device d{writer, MemoryLayout{{{2, 2, 2, 2}}, {{8, 0, 0, 0}}}};
+    mock().enable();
+
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0028);
+    constexpr std::uint16_t value{0x1ffd};
+    expectRead(address, value);
+
+    constexpr std::uint16_t size{5};
+    const auto buffer = createBuffer(size);
+    const std::span expected{buffer};
+    expectReadBlock(0x7ffd, expected.first(3));
+    expectReadBlock(0x6000, expected.subspan(3));
+    expectWrite(address, std::uint16_t{value + size});
+
+    std::array<std::uint8_t, size> data{};
+    d.receiveData(socketHandle, data);
+    CHECK_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin()));
+}
+
+TEST(W5100DeviceTest, readReceivePointer)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0028);
+    constexpr std::uint16_t value{0x1234};
+    expectRead(address, value);
+
+    CHECK_EQUAL(value, device->readReceivePointer(socketHandle));
+}
+
+TEST(W5100DeviceTest, writeTransmitPointer)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0024);
+    constexpr std::uint16_t value{0x1234};
+    expectWrite(address, value);
+
+    device->writeTransmitPointer(socketHandle, value);
+}
+
+TEST(W5100DeviceTest, readReceiveBufferAtPointerWraps)
+{
+    constexpr std::uint16_t pointer{0x27ff};
+    const auto buffer = createBuffer(3);
+    const std::span expected{buffer};
+    expectReadBlock(0x67ff, expected.first(1));
+    expectReadBlock(0x6000, expected.subspan(1));
+
+    std::array<std::uint8_t, 3> data{};
+    device->readReceiveBuffer(socketHandle, pointer, data);
+    CHECK_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin()));
+}
+
+TEST(W5100DeviceTest, writeTransmitBufferAtPointer)
+{
+    constexpr std::uint16_t pointer{0x1010};
+    const auto buffer = createBuffer(3);
+    expectWriteBlock(0x4010, buffer);
+
+    device->writeTransmitBuffer(socketHandle, pointer, buffer);
+}
+
+TEST(W5100DeviceTest, sendDataAsyncStartsDmaTransfer)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0024);
+    constexpr std::uint16_t value{0x07fe};
+    mock("SpiDma").expectOneCall("isBusy").andReturnValue(false);
+    expectRead(address, value);
+
+    constexpr std::uint16_t size{5};
+    const auto buffer = createBuffer(size);
+    const std::span data{buffer};
+    expectDmaWriteSegment(0x47fe, data.first(2));
+    expectDmaWriteSegment(0x4000, data.subspan(2));
+    mock("SpiDma").expectOneCall("startWrite").andReturnValue(true);
+
+    CHECK_TRUE(device->sendDataAsync(socketHandle, buffer, dma, nullptr, nullptr));
+}
+
+TEST(W5100DeviceTest, sendDataAsyncWritesPointerOnCompletion)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0024);
+    constexpr std::uint16_t value{0x07fe};
+    constexpr std::uint16_t size{5};
+    const auto buffer = createBuffer(size);
+    TransferResult result{0, false};
+    mock("SpiDma").expectOneCall("isBusy").andReturnValue(false);
+    expectRead(address, value);
+    mock("SpiDma").ignoreOtherCalls();
+
+    device->sendDataAsync(socketHandle, buffer, dma, recordTransfer, &result);
+    expectWrite(address, std::uint16_t{value + size});
+    dma.onComplete(nullptr);
+
+    CHECK_EQUAL(1, result.calls);
+    CHECK_TRUE(result.success);
+    CHECK_EQUAL(value + size, device->readTransmitPointer(socketHandle));
+}
+
+TEST(W5100DeviceTest, sendDataAsyncKeepsPointerOnError)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0024);
+    constexpr std::uint16_t value{0x07fe};
+    const auto buffer = createBuffer(5);
+    TransferResult result{0, true};
+    mock("SpiDma").expectOneCall("isBusy").andReturnValue(false);
+    expectRead(address, value);
+    mock("SpiDma").ignoreOtherCalls();
+
+    device->sendDataAsync(socketHandle, buffer, dma, recordTransfer, &result);
+    dma.onError(nullptr);
+
+    CHECK_EQUAL(1, result.calls);
+    CHECK_FALSE(result.success);
+    CHECK_EQUAL(value, device->readTransmitPointer(socketHandle));
+}
+
+TEST(W5100DeviceTest, sendDataAsyncKeepsPointerIfStartFails)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0024);
+    constexpr std::uint16_t value{0x07fe};
+    const auto buffer = createBuffer(5);
+    mock("SpiDma").expectOneCall("isBusy").andReturnValue(false);
+    expectRead(address, value);
+    mock("SpiDma").expectNCalls(2, "writeSegment").ignoreOtherParameters();
+    mock("SpiDma").expectOneCall("startWrite").andReturnValue(false);
+
+    CHECK_FALSE(device->sendDataAsync(socketHandle, buffer, dma, nullptr, nullptr));
+    CHECK_EQUAL(value, device->readTransmitPointer(socketHandle));
+}
+
+TEST(W5100DeviceTest, sendDataAsyncFailsIfDmaBusy)
+{
+    mock("SpiDma").expectOneCall("isBusy").andReturnValue(true);
+
+    const auto buffer = createBuffer(5);
+    CHECK_FALSE(device->sendDataAsync(socketHandle, buffer, dma, nullptr, nullptr));
+}
+
+TEST(W5100DeviceTest, receiveDataAsyncStartsDmaTransfer)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0028);
+    constexpr std::uint16_t value{0x3355};
+    mock("SpiDma").expectOneCall("isBusy").andReturnValue(false);
+    expectRead(address, value);
+
+    constexpr std::uint16_t size{4};
+    const auto buffer = createBuffer(size);
+    expectDmaReadSegment(0x6355, buffer);
+    expectDmaReadSegment(0x6000, std::span<const std::uint8_t>{});
+    mock("SpiDma").expectOneCall("startRead").andReturnValue(true);
+
+    std::array<std::uint8_t, size> data{};
+    CHECK_TRUE(device->receiveDataAsync(socketHandle, data, dma, nullptr, nullptr));
+    CHECK_TRUE(std::equal(buffer.begin(), buffer.end(), data.begin()));
+}
+
+TEST(W5100DeviceTest, receiveDataAsyncWritesPointerOnCompletion)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0028);
+    constexpr std::uint16_t value{0x3355};
+    constexpr std::uint16_t size{4};
+    std::array<std::uint8_t, size> data{};
+    TransferResult result{0, false};
+    mock("SpiDma").expectOneCall("isBusy").andReturnValue(false);
+    expectRead(address, value);
+    mock("SpiDma").ignoreOtherCalls();
+
+    device->receiveDataAsync(socketHandle, data, dma, recordTransfer, &result);
+    expectWrite(address, std::uint16_t{value + size});
+    dma.onComplete(nullptr);
+
+    CHECK_EQUAL(1, result.calls);
+    CHECK_TRUE(result.success);
+}
+
+TEST(W5100DeviceTest, receiveDataAsyncKeepsPointerOnError)
+{
+    constexpr std::uint16_t address = toAddress(socketHandle, 0x0028);
+    constexpr std::uint16_t value{0x3355};
+    std::array<std::uint8_t, 4> data{};
+    TransferResult result{0, true};
+    mock("SpiDma").expectOneCall("isBusy").andReturnValue(false);
+    expectRead(address, value);
+    mock("SpiDma").ignoreOtherCalls();
+
+    device->receiveDataAsync(socketHandle, data, dma, recordTransfer, &result);
+    dma.onError(nullptr);
+
+    CHECK_EQUAL(1, result.calls);
+    CHECK_FALSE(result.success);
+    CHECK_EQUAL(value, device->readReceivePointer(socketHandle));
 }
 
 TEST(W5100DeviceTest, writeModeRegister)
@@ -397,12 +808,42 @@ TEST(W5100DeviceTest, setDestAddress)
     constexpr std::uint16_t addressPort = toAddress(socketHandle, 0x0010);
     eth::NetAddress<4> ip{{192, 168, 1, 4}};
     constexpr std::uint16_t port{1234};
-    expectWrite(addressIp, ip);
+    expectWriteBlock(addressIp, ip);
     expectWrite(addressPort, port);
 
     device->setDestAddress(socketHandle, ip, port);
 }
 
+TEST(W5100DeviceTest, setDestAddressSuppressesRedundantWrite)
+{
+    constexpr std::uint16_t addressPort = toAddress(socketHandle, 0x0010);
+    eth::NetAddress<4> ip{{192, 168, 1, 4}};
+    expectWriteBlock(toAddress(socketHandle, 0x000c), ip);
+    expectWrite(addressPort, std::uint16_t{1234});
+    expectWrite(addressPort, std::uint16_t{1235});
+
+    device->setDestAddress(socketHandle, ip, 1234);
+    device->setDestAddress(socketHandle, ip, 1234);
+    device->setDestAddress(socketHandle, ip, 1235);
+}
+
+TEST(W5100DeviceTest, listenInvalidatesDestAddressShadow)
+{
+    constexpr std::uint16_t addressPort = toAddress(socketHandle, 0x0010);
+    constexpr std::uint16_t addressCommand = toAddress(socketHandle, 0x0001);
+    eth::NetAddress<4> ip{{192, 168, 1, 4}};
+    expectWriteBlock(toAddress(socketHandle, 0x000c), ip);
+    expectWrite(addressPort, std::uint16_t{1234});
+    expectWrite(addressCommand, static_cast<std::uint8_t>(SocketCommand::listen));
+    expectRead(addressCommand, std::uint8_t{0x00});
+    expectWriteBlock(toAddress(socketHandle, 0x000c), ip);
+    expectWrite(addressPort, std::uint16_t{1234});
+
+    device->setDestAddress(socketHandle, ip, 1234);
+    device->executeSocketCommand(socketHandle, SocketCommand::listen);
+    device->setDestAddress(socketHandle, ip, 1234);
+}
+
 TEST(W5100DeviceTest, configureNetConfiguration)
 {
     constexpr eth::NetConfig config{
@@ -415,10 +856,25 @@ TEST(W5100DeviceTest, configureNetConfiguration)
     constexpr std::uint16_t addrGateway{0x0001};
     constexpr std::uint16_t addrMac{0x0009};
 
-    expectWrite(addrIp, ip);
-    expectWrite(addrNetmask, netmask);
-    expectWrite(addrGateway, gateway);
-    expectWrite(addrMac, mac);
+    expectWriteBlock(addrIp, ip);
+    expectWriteBlock(addrNetmask, netmask);
+    expectWriteBlock(addrGateway, gateway);
+    expectWriteBlock(addrMac, mac);
+
+    setupDevice(*device, config);
+}
 
+TEST(W5100DeviceTest, configureNetConfigurationTwiceWritesOnce)
+{
+    constexpr eth::NetConfig config{
+        {{192, 168, 0, 3}}, {{255, 255, 255, 0}}, {{192, 168, 0, 1}}, {{0x00, 0x08, 0xdc, 0x01, 0x02, 0x03}}};
+    const auto [ip, netmask, gateway, mac] = config;
+    expectWriteBlock(0x000f, ip);
+    expectWriteBlock(0x0005, netmask);
+    expectWriteBlock(0x0001, gateway);
+    expectWriteBlock(0x0009, mac);
+
+    setupDevice(*device, config);
     setupDevice(*device, config);
+    CHECK_TRUE(device->readNetConfig() == config);
 }
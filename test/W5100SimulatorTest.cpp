@@ -0,0 +1,162 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sim/W5100Simulator.h"
+#include "w5100/Device.h"
+#include "Socket.h"
+#include "TestHelper.h"
+#include <vector>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::Socket;
+using eth::SocketHandle;
+using eth::SocketStatus;
+using eth::sim::W5100Simulator;
+
+
+namespace
+{
+    constexpr inline SocketHandle socketHandle = eth::makeHandle<0>();
+    constexpr eth::NetAddress<4> address{{192, 168, 0, 5}};
+}
+
+
+TEST_GROUP(W5100SimulatorTest)
+{
+    void setup() override
+    {
+        mock("platform").ignoreOtherCalls();
+    }
+
+    void teardown() override
+    {
+        mock().clear();
+    }
+
+    void connect()
+    {
+        CHECK_EQUAL(Socket::Status::ok, socket.open(eth::Protocol::tcp, 5000, 0));
+        CHECK_EQUAL(Socket::Status::ok, socket.connect(address, 6000));
+    }
+
+
+    W5100Simulator simulator{8'000'000};
+    eth::w5100::BasicDevice<W5100Simulator> device{simulator};
+    Socket socket{socketHandle, device};
+};
+
+TEST(W5100SimulatorTest, openAndConnectEstablishes)
+{
+    CHECK_EQUAL(Socket::Status::ok, socket.open(eth::Protocol::tcp, 5000, 0));
+    CHECK_EQUAL(SocketStatus::init, simulator.status(socketHandle));
+
+    CHECK_EQUAL(Socket::Status::ok, socket.connect(address, 6000));
+    CHECK_EQUAL(SocketStatus::established, simulator.status(socketHandle));
+}
+
+TEST(W5100SimulatorTest, listenUntilPeerConnects)
+{
+    CHECK_EQUAL(Socket::Status::ok, socket.open(eth::Protocol::tcp, 5000, 0));
+    CHECK_EQUAL(Socket::Status::ok, socket.listen());
+    CHECK_EQUAL(SocketStatus::listen, simulator.status(socketHandle));
+
+    simulator.acceptConnection(socketHandle);
+    CHECK_EQUAL(SocketStatus::established, socket.getStatus());
+}
+
+TEST(W5100SimulatorTest, sendTransmitsPayload)
+{
+    connect();
+    const auto data = createBuffer(100);
+
+    CHECK_EQUAL(100, socket.send(data));
+    CHECK_TRUE(simulator.takeTransmitted(socketHandle) == data);
+    CHECK_EQUAL(2048, device.getTransmitFreeSize(socketHandle));
+}
+
+TEST(W5100SimulatorTest, sendWrapsAroundTransmitRing)
+{
+    connect();
+    const auto data = createBuffer(1500);
+
+    CHECK_EQUAL(1500, socket.send(data));
+    CHECK_EQUAL(1500, socket.send(data));
+
+    std::vector<std::uint8_t> expected{data};
+    expected.insert(expected.end(), data.cbegin(), data.cend());
+    CHECK_TRUE(simulator.takeTransmitted(socketHandle) == expected);
+    CHECK_EQUAL(3000, device.readTransmitPointer(socketHandle));
+}
+
+TEST(W5100SimulatorTest, receiveWrapsAroundReceiveRing)
+{
+    connect();
+    const auto data = createBuffer(1500);
+    std::vector<std::uint8_t> buffer(data.size());
+
+    CHECK_TRUE(simulator.injectReceive(socketHandle, data));
+    CHECK_EQUAL(1500, socket.receive(buffer));
+    CHECK_TRUE(simulator.injectReceive(socketHandle, data));
+    CHECK_EQUAL(1500, socket.receive(buffer));
+
+    CHECK_TRUE(buffer == data);
+    CHECK_EQUAL(0, device.getReceiveFreeSize(socketHandle));
+}
+
+TEST(W5100SimulatorTest, injectReceiveRejectsOverflow)
+{
+    connect();
+    const auto data = createBuffer(1500);
+
+    CHECK_TRUE(simulator.injectReceive(socketHandle, data));
+    CHECK_FALSE(simulator.injectReceive(socketHandle, data));
+}
+
+TEST(W5100SimulatorTest, peerCloseIsReported)
+{
+    connect();
+    simulator.closeByPeer(socketHandle);
+
+    CHECK_EQUAL(SocketStatus::closeWait, socket.getStatus());
+    CHECK_TRUE(device.readSocketInterruptRegister(socketHandle).test(eth::SocketInterrupt::Mask::disconnect));
+    CHECK_EQUAL(0x01, device.readInterruptRegister());
+}
+
+TEST(W5100SimulatorTest, statisticsCountFramesAndWireTime)
+{
+    simulator.resetStatistics();
+    device.writeSocketSourcePort(socketHandle, 5000);
+
+    const auto stats = simulator.statistics();
+    CHECK_EQUAL(2, stats.frames);
+    CHECK_EQUAL(8, stats.bytes);
+    CHECK_EQUAL(4, stats.chipSelectToggles);
+    CHECK_EQUAL(8000, stats.wireTimeNs);
+}
+
+TEST(W5100SimulatorTest, resetRestoresDefaults)
+{
+    connect();
+    device.writeModeRegister(eth::Mode::reset);
+
+    CHECK_EQUAL(SocketStatus::closed, simulator.status(socketHandle));
+    CHECK_EQUAL(2048, device.getTransmitFreeSize(socketHandle));
+}
@@ -0,0 +1,119 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "w5100/Device.h"
+#include "TestHelper.h"
+#include <array>
+#include <vector>
+#include <CppUTest/TestHarness.h>
+
+using eth::SocketHandle;
+using eth::w5100::BasicDevice;
+
+
+namespace
+{
+    class MemoryTransport
+    {
+    public:
+        void write(std::uint16_t address, std::uint8_t data)
+        {
+            memory[address] = data;
+            ++frames;
+        }
+
+        std::uint8_t read(std::uint16_t address)
+        {
+            ++frames;
+            return memory[address];
+        }
+
+        void writeBlock(std::uint16_t address, std::span<const std::uint8_t> data)
+        {
+            std::copy(data.begin(), data.end(), std::next(memory.begin(), address));
+            frames += data.size();
+        }
+
+        void readBlock(std::uint16_t address, std::span<std::uint8_t> data)
+        {
+            std::copy_n(std::next(memory.cbegin(), address), data.size(), data.begin());
+            frames += data.size();
+        }
+
+
+        std::array<std::uint8_t, 0x8000> memory{};
+        std::size_t frames{0};
+    };
+
+    static_assert(eth::Transport<MemoryTransport>);
+    static_assert(eth::Transport<eth::spi::SpiWriter>);
+    static_assert(!eth::Transport<int>);
+
+    constexpr inline SocketHandle socketHandle = eth::makeHandle<1>();
+}
+
+
+TEST_GROUP(W5100TransportTest)
+{
+    MemoryTransport transport;
+};
+
+TEST(W5100TransportTest, initWritesMemorySizeToTransport)
+{
+    transport.memory[0x001b] = 0xff;
+    transport.memory[0x001a] = 0xff;
+
+    [[maybe_unused]] BasicDevice<MemoryTransport> device{transport};
+    CHECK_EQUAL(0x80, transport.memory[0x0000]);
+    CHECK_EQUAL(0x55, transport.memory[0x001b]);
+    CHECK_EQUAL(0x55, transport.memory[0x001a]);
+}
+
+TEST(W5100TransportTest, sendDataWrapsAroundTransmitBuffer)
+{
+    BasicDevice<MemoryTransport> device{transport};
+    transport.memory[0x0524] = 0x07;
+    transport.memory[0x0525] = 0xfe;
+    const auto data = createBuffer(4);
+
+    device.sendData(socketHandle, data);
+
+    CHECK_EQUAL(data[0], transport.memory[0x4ffe]);
+    CHECK_EQUAL(data[1], transport.memory[0x4fff]);
+    CHECK_EQUAL(data[2], transport.memory[0x4800]);
+    CHECK_EQUAL(data[3], transport.memory[0x4801]);
+    CHECK_EQUAL(0x0802, device.readTransmitPointer(socketHandle));
+}
+
+TEST(W5100TransportTest, receiveDataWrapsAroundReceiveBuffer)
+{
+    BasicDevice<MemoryTransport> device{transport};
+    transport.memory[0x0528] = 0x0f;
+    transport.memory[0x0529] = 0xff;
+    transport.memory[0x6fff] = 0xaa;
+    transport.memory[0x6800] = 0xbb;
+
+    std::vector<std::uint8_t> buffer(2);
+    device.receiveData(socketHandle, buffer);
+
+    CHECK_EQUAL(0xaa, buffer[0]);
+    CHECK_EQUAL(0xbb, buffer[1]);
+    CHECK_EQUAL(0x1001, device.readReceivePointer(socketHandle));
+}
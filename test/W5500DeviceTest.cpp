@@ -0,0 +1,262 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "w5500/Device.h"
+#include "w5500/Registers.h"
+#include "spi/SpiWriter.h"
+#include "Socket.h"
+#include "TestHelper.h"
+#include <array>
+#include <memory>
+#include <CppUTest/TestHarness.h>
+#include <CppUTestExt/MockSupport.h>
+
+using eth::SocketCommand;
+using eth::SocketHandle;
+using eth::SocketInterrupt;
+using eth::SocketStatus;
+using eth::spi::SpiWriter;
+using eth::w5500::Device;
+using eth::w5500::makeRegister;
+
+
+namespace
+{
+    constexpr inline SocketHandle socketHandle = eth::w5500::makeHandle<0>();
+    constexpr inline SocketHandle lastSocketHandle = eth::w5500::makeHandle<7>();
+
+    constexpr std::uint8_t commonBlock{0x00};
+    constexpr std::uint8_t writeAccess{0x04};
+    constexpr std::uint8_t readAccess{0x00};
+
+    constexpr std::uint8_t control(std::uint8_t block, std::uint8_t access)
+    {
+        return static_cast<std::uint8_t>((block << 3) | access);
+    }
+}
+
+
+TEST_GROUP(W5500DeviceTest)
+{
+    void setup() override
+    {
+        mock().strictOrder();
+        mock().disable();
+        device = std::make_unique<Device>(writer);
+        mock().enable();
+    }
+
+    void teardown() override
+    {
+        mock().checkExpectations();
+        mock().clear();
+    }
+
+    template <class Container>
+    void expectWriteFrame(std::uint16_t addr, std::uint8_t block, const Container& data) const
+    {
+        const std::array<std::uint8_t, 3> header{{eth::byte::get<1>(addr), eth::byte::get<0>(addr), control(block, writeAccess)}};
+        mock("SpiWriter")
+            .expectOneCall("writeFrame")
+            .withMemoryBufferParameter("header", header.data(), header.size())
+            .withMemoryBufferParameter("data", data.data(), data.size())
+            .withParameter("size", data.size());
+    }
+
+    template <class Container>
+    void expectReadFrame(std::uint16_t addr, std::uint8_t block, const Container& data) const
+    {
+        const std::array<std::uint8_t, 3> header{{eth::byte::get<1>(addr), eth::byte::get<0>(addr), control(block, readAccess)}};
+        mock("SpiWriter")
+            .expectOneCall("readFrame")
+            .withMemoryBufferParameter("header", header.data(), header.size())
+            .withOutputParameterReturning("data", data.data(), data.size())
+            .withParameter("size", data.size());
+    }
+
+    static constexpr std::uint8_t socketBlock(SocketHandle s)
+    {
+        return static_cast<std::uint8_t>(s.value() * 4 + 1);
+    }
+
+
+    std::unique_ptr<Device> device;
+    SpiWriter writer{eth::spi::spi2};
+};
+
+TEST(W5500DeviceTest, initResetsAndSetsBufferSizes)
+{
+    expectWriteFrame(0x0000, commonBlock, std::array<std::uint8_t, 1>{{0x80}});
+
+    for (std::uint8_t i = 0; i < eth::w5500::supportedSockets; ++i)
+    {
+        const SocketHandle s{i};
+        const std::uint8_t transmitSize = (i < 4) ? 4 : 0;
+        expectWriteFrame(0x001e, socketBlock(s), std::array<std::uint8_t, 1>{{1}});
+        expectWriteFrame(0x001f, socketBlock(s), std::array<std::uint8_t, 1>{{transmitSize}});
+    }
+
+    const Device d{writer, {{4, 4, 4, 4, 0, 0, 0, 0}}, {{1, 1, 1, 1, 1, 1, 1, 1}}};
+    CHECK_EQUAL(4096, d.getTransmitBufferSize(socketHandle));
+    CHECK_EQUAL(1024, d.getReceiveBufferSize(lastSocketHandle));
+    CHECK_EQUAL(0, d.getReceiveBufferAddress(lastSocketHandle));
+    CHECK_EQUAL(8, d.getSocketCount());
+}
+
+TEST(W5500DeviceTest, writeRegisterUsesSingleFrame)
+{
+    expectWriteFrame(0x0004, socketBlock(lastSocketHandle), std::array<std::uint8_t, 2>{{0x12, 0x34}});
+    device->writeSocketSourcePort(lastSocketHandle, 0x1234);
+}
+
+TEST(W5500DeviceTest, readRegisterUsesSingleFrame)
+{
+    expectReadFrame(0x0024, socketBlock(socketHandle), std::array<std::uint8_t, 2>{{0xab, 0xcd}});
+    CHECK_EQUAL(0xabcd, device->readTransmitPointer(socketHandle));
+}
+
+TEST(W5500DeviceTest, executeSocketCommandWaitsForCompletion)
+{
+    const auto block = socketBlock(socketHandle);
+    expectWriteFrame(0x0001, block, std::array<std::uint8_t, 1>{{0x20}});
+    expectReadFrame(0x0001, block, std::array<std::uint8_t, 1>{{0x20}});
+    expectReadFrame(0x0001, block, std::array<std::uint8_t, 1>{{0x00}});
+
+    device->executeSocketCommand(socketHandle, SocketCommand::send);
+}
+
+TEST(W5500DeviceTest, readSocketStatusRegister)
+{
+    expectReadFrame(0x0003, socketBlock(socketHandle), std::array<std::uint8_t, 1>{{0x17}});
+    CHECK_EQUAL(SocketStatus::established, device->readSocketStatusRegister(socketHandle));
+}
+
+TEST(W5500DeviceTest, readSocketStateUsesSingleBurst)
+{
+    std::array<std::uint8_t, 0x2c> block{};
+    block[0x02] = 0x04;
+    block[0x03] = 0x17;
+    block[0x20] = 0x08;
+    block[0x26] = 0x01;
+    block[0x27] = 0x02;
+    expectReadFrame(0x0000, socketBlock(lastSocketHandle), block);
+
+    const auto state = device->readSocketState(lastSocketHandle);
+    CHECK_EQUAL(SocketStatus::established, state.status);
+    CHECK_TRUE(state.interrupt.test(SocketInterrupt::Mask::receive));
+    CHECK_EQUAL(0x0800, state.transmitFreeSize);
+    CHECK_EQUAL(0x0102, state.receivedSize);
+}
+
+TEST(W5500DeviceTest, interruptRegistersUseCommonBlock)
+{
+    expectReadFrame(0x0017, commonBlock, std::array<std::uint8_t, 1>{{0x81}});
+    expectWriteFrame(0x0018, commonBlock, std::array<std::uint8_t, 1>{{0xff}});
+
+    CHECK_EQUAL(0x81, device->readInterruptRegister());
+    device->writeInterruptMaskRegister(0xff);
+}
+
+TEST(W5500DeviceTest, sendDataWritesTransmitBlockWithoutWrapSplit)
+{
+    const auto data = createBuffer(10);
+    const auto block = socketBlock(lastSocketHandle);
+    expectReadFrame(0x0024, block, std::array<std::uint8_t, 2>{{0xff, 0xfc}});
+    expectWriteFrame(0xfffc, block + 1, data);
+    expectWriteFrame(0x0024, block, std::array<std::uint8_t, 2>{{0x00, 0x06}});
+
+    device->sendData(lastSocketHandle, data);
+}
+
+TEST(W5500DeviceTest, sendSegmentsWritesEachSegment)
+{
+    const std::array<std::uint8_t, 2> header{{0x01, 0x02}};
+    const std::array<std::uint8_t, 3> payload{{0x03, 0x04, 0x05}};
+    const std::array<std::span<const std::uint8_t>, 3> segments{{header, {}, payload}};
+    const auto block = socketBlock(socketHandle);
+    expectReadFrame(0x0024, block, std::array<std::uint8_t, 2>{{0x00, 0x10}});
+    expectWriteFrame(0x0010, block + 1, header);
+    expectWriteFrame(0x0012, block + 1, payload);
+    expectWriteFrame(0x0024, block, std::array<std::uint8_t, 2>{{0x00, 0x15}});
+
+    device->sendData(socketHandle, segments);
+}
+
+TEST(W5500DeviceTest, receiveDataReadsReceiveBlock)
+{
+    const auto data = createBuffer(5);
+    const auto block = socketBlock(socketHandle);
+    expectReadFrame(0x0028, block, std::array<std::uint8_t, 2>{{0x07, 0xfe}});
+    expectReadFrame(0x07fe, block + 2, data);
+    expectWriteFrame(0x0028, block, std::array<std::uint8_t, 2>{{0x08, 0x03}});
+
+    std::vector<std::uint8_t> buffer(data.size());
+    CHECK_EQUAL(5, device->receiveData(socketHandle, buffer));
+    CHECK_TRUE(buffer == data);
+}
+
+TEST(W5500DeviceTest, peekReturnsReceiveBlockOffsets)
+{
+    const auto block = socketBlock(lastSocketHandle);
+    expectReadFrame(0x0026, block, std::array<std::uint8_t, 2>{{0x00, 0x0a}});
+    expectReadFrame(0x0026, block, std::array<std::uint8_t, 2>{{0x00, 0x0a}});
+    expectReadFrame(0x0028, block, std::array<std::uint8_t, 2>{{0x27, 0xfc}});
+
+    auto socket = std::make_unique<eth::Socket>(lastSocketHandle, *device);
+    const auto view = socket->peek();
+    CHECK_EQUAL(0x27fc, view.pointer);
+    CHECK_EQUAL(0x07fc, view.segments[0].address);
+    CHECK_EQUAL(4, view.segments[0].size);
+    CHECK_EQUAL(0x0000, view.segments[1].address);
+    CHECK_EQUAL(6, view.segments[1].size);
+
+    mock().disable();
+    socket.reset();
+    mock().enable();
+}
+
+TEST(W5500DeviceTest, setDestAddress)
+{
+    const eth::NetAddress<4> address{{192, 168, 0, 3}};
+    expectWriteFrame(0x000c, socketBlock(socketHandle), address);
+    expectWriteFrame(0x0010, socketBlock(socketHandle), std::array<std::uint8_t, 2>{{0x13, 0x88}});
+
+    device->setDestAddress(socketHandle, address, 5000);
+}
+
+TEST(W5500DeviceTest, setupDeviceWritesNetConfig)
+{
+    const eth::NetConfig config{{{192, 168, 0, 3}}, {{255, 255, 255, 0}}, {{192, 168, 0, 1}}, {{0x00, 0x08, 0xdc, 0x01, 0x02, 0x03}}};
+    expectWriteFrame(0x000f, commonBlock, std::get<0>(config));
+    expectWriteFrame(0x0005, commonBlock, std::get<1>(config));
+    expectWriteFrame(0x0001, commonBlock, std::get<2>(config));
+    expectWriteFrame(0x0009, commonBlock, std::get<3>(config));
+
+    eth::w5500::setupDevice(*device, config);
+}
+
+TEST(W5500DeviceTest, registerBlocks)
+{
+    CHECK_EQUAL(0x00, eth::w5500::registers::mode.block());
+    CHECK_EQUAL(0x1d, eth::w5500::registers::socketStatus(lastSocketHandle).block());
+    CHECK_EQUAL(0x1e, eth::w5500::block::transmitBuffer(lastSocketHandle));
+    CHECK_EQUAL(0x1f, eth::w5500::block::receiveBuffer(lastSocketHandle));
+    CHECK_EQUAL(0x0003, makeRegister<std::uint8_t>(socketHandle, 0x0003).address());
+}
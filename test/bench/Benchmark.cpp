@@ -0,0 +1,140 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sim/W5100Simulator.h"
+#include "w5100/Device.h"
+#include "Protocol.h"
+#include <array>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    using eth::sim::SpiStatistics;
+    using eth::sim::W5100Simulator;
+    using BenchDevice = eth::w5100::BasicDevice<W5100Simulator>;
+
+    constexpr auto socketHandle = eth::makeHandle<0>();
+    constexpr eth::w5100::MemoryLayout benchLayout{{{8, 0, 0, 0}}, {{8, 0, 0, 0}}};
+    constexpr std::array<std::size_t, 14> payloadSizes{{1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192}};
+
+    constexpr auto config =
+        eth::NetConfig{{{192, 168, 1, 8}}, {{255, 255, 255, 0}}, {{192, 168, 1, 1}}, {{0x00, 0x08, 0xdc, 0xab, 0xcd, 0xef}}};
+
+
+    void printHeader()
+    {
+        std::printf("%-22s %8s %10s %10s %10s %12s %10s\n", "operation", "payload", "frames", "bytes", "cs", "time [us]", "B/frame");
+    }
+
+    void printResult(const char* name, std::size_t payload, const SpiStatistics& stats)
+    {
+        const double efficiency = (stats.frames > 0) ? static_cast<double>(payload) / static_cast<double>(stats.frames) : 0.0;
+        std::printf("%-22s %8zu %10llu %10llu %10llu %12.2f %10.3f\n",
+                    name,
+                    payload,
+                    static_cast<unsigned long long>(stats.frames),
+                    static_cast<unsigned long long>(stats.bytes),
+                    static_cast<unsigned long long>(stats.chipSelectToggles),
+                    static_cast<double>(stats.wireTimeNs) / 1000.0,
+                    efficiency);
+    }
+
+    void openSocket(BenchDevice& device)
+    {
+        device.writeSocketModeRegister(socketHandle, static_cast<std::uint8_t>(eth::Protocol::tcp));
+        device.writeSocketSourcePort(socketHandle, 5000);
+        device.executeSocketCommand(socketHandle, eth::SocketCommand::open);
+        device.setDestAddress(socketHandle, {{192, 168, 1, 9}}, 5000);
+        device.executeSocketCommand(socketHandle, eth::SocketCommand::connect);
+    }
+
+    void warmPointerCache(BenchDevice& device, W5100Simulator& simulator)
+    {
+        std::array<std::uint8_t, 1> data{};
+        device.sendData(socketHandle, data);
+        device.executeSocketCommand(socketHandle, eth::SocketCommand::send);
+        simulator.injectReceive(socketHandle, data);
+        device.receiveData(socketHandle, data);
+        device.executeSocketCommand(socketHandle, eth::SocketCommand::receive);
+        simulator.takeTransmitted(socketHandle);
+    }
+
+    template <class Operation>
+    SpiStatistics measure(W5100Simulator& simulator, Operation op)
+    {
+        simulator.resetStatistics();
+        op();
+        return simulator.statistics();
+    }
+
+}
+
+
+int main(int argc, char* argv[])
+{
+    const std::uint32_t spiClock = (argc > 1) ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : W5100Simulator::defaultSpiClock;
+
+    if (spiClock == 0)
+    {
+        std::fprintf(stderr, "Usage: %s [spi clock in Hz]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::printf("SPI clock: %u Hz\n", static_cast<unsigned int>(spiClock));
+    std::printf("sendData / receiveData: buffer pointers cached (warm)\n\n");
+
+    W5100Simulator simulator{spiClock};
+    BenchDevice device{simulator, benchLayout};
+
+    printHeader();
+    printResult("setupDevice", 0, measure(simulator, [&device]
+                                          { eth::w5100::setupDevice(device, config); }));
+    openSocket(device);
+    printResult("executeSocketCommand", 0, measure(simulator, [&device]
+                                                   { device.executeSocketCommand(socketHandle, eth::SocketCommand::send); }));
+    printResult("readFreesize", 0, measure(simulator, [&device]
+                                           { device.getTransmitFreeSize(socketHandle); }));
+    printResult("readSocketState", 0, measure(simulator, [&device]
+                                              { device.readSocketState(socketHandle); }));
+
+    warmPointerCache(device, simulator);
+
+    for (const auto size : payloadSizes)
+    {
+        const std::vector<std::uint8_t> payload(size, 0xa5);
+        printResult("sendData", size, measure(simulator, [&device, &payload]
+                                              { device.sendData(socketHandle, payload); }));
+        device.executeSocketCommand(socketHandle, eth::SocketCommand::send);
+        simulator.takeTransmitted(socketHandle);
+    }
+
+    for (const auto size : payloadSizes)
+    {
+        std::vector<std::uint8_t> buffer(size);
+        simulator.injectReceive(socketHandle, buffer);
+        printResult("receiveData", size, measure(simulator, [&device, &buffer]
+                                                 { device.receiveData(socketHandle, buffer); }));
+        device.executeSocketCommand(socketHandle, eth::SocketCommand::receive);
+    }
+
+    return EXIT_SUCCESS;
+}
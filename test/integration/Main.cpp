@@ -21,8 +21,11 @@
 #include <stm32f4xx_hal.h>
 #include <diag/Trace.h>
 #include "Socket.h"
+#include "TcpServer.h"
 #include "w5100/Device.h"
 #include "spi/SpiWriter.h"
+#include <algorithm>
+#include <array>
 
 void spiClockEnable()
 {
@@ -43,59 +46,62 @@ int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
     eth::w5100::Device device(writer);
     eth::w5100::setupDevice(device, config);
 
-    eth::Socket socket(eth::makeHandle<0>(), device);
     constexpr std::uint16_t port{5000};
+    eth::TcpServer server(device, port);
 
     trace_puts("Server: 192.168.1.8:5000");
 
-    while (true)
+    if (server.listen() != eth::Socket::Status::ok)
     {
-        if (socket.open(eth::Protocol::tcp, port, 0) != eth::Socket::Status::ok)
-        {
-            trace_puts("socket() failed");
-        }
-        else
-        {
-            trace_puts("socket() ok");
-        }
+        trace_puts("listen() failed");
+    }
+    else
+    {
+        trace_printf("listen() ok (backlog %d)\n", server.backlog());
+    }
 
 
-        if (socket.listen() != eth::Socket::Status::ok)
-        {
-            trace_puts("listen() failed");
-        }
-        else
+    std::array<eth::Socket*, eth::supportedSockets> clients{};
+
+    while (true)
+    {
+        if (auto* accepted = server.accept(); accepted != nullptr)
         {
-            trace_puts("listen() ok");
+            *std::find(clients.begin(), clients.end(), nullptr) = accepted;
+            trace_printf("accept() done (%d connected)\n", server.connections());
         }
 
 
-        socket.accept();
-        trace_puts("accept() done");
+        for (auto& client : clients)
+        {
+            if (client == nullptr)
+            {
+                continue;
+            }
 
+            std::array<std::uint8_t, 20> buffer;
+            const auto result = client->tryReceive(buffer);
 
-        while (true)
-        {
-            if (socket.getStatus() == eth::SocketStatus::established)
+            if (result.status == eth::Socket::Status::closed)
+            {
+                server.release(*client);
+                client = nullptr;
+                trace_printf("release() done (%d connected)\n", server.connections());
+            }
+            else if (result.size > 0)
             {
-                std::array<std::uint8_t, 20> buffer;
+                trace_printf("receive(): %d\n", result.size);
 
-                const auto received = socket.receive(buffer);
-                trace_printf("receive(): %d\n", received);
+                std::array<std::uint8_t, 9> resp{{'r', 'e', 'c', 'e', 'i', 'v', 'e', 'd', '\n'}};
+                const auto n = client->send(resp);
 
-                if (received > 0)
+                if (n != resp.size())
+                {
+                    trace_printf("send() failed (%d)\n", n);
+                }
+                else
                 {
-                    std::array<std::uint8_t, 9> resp{{'r', 'e', 'c', 'e', 'i', 'v', 'e', 'd', '\n'}};
-                    const auto n = socket.send(resp);
-
-                    if (n != resp.size())
-                    {
-                        trace_printf("send() failed (%d)\n", n);
-                    }
-                    else
-                    {
-                        trace_printf("send() ok (%d / %d)\n", n, resp.size());
-                    }
+                    trace_printf("send() ok (%d / %d)\n", n, resp.size());
                 }
             }
         }
@@ -0,0 +1,198 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "NetDeviceMock.h"
+#include <CppUTestExt/MockSupport.h>
+
+namespace eth::test
+{
+
+    NetDeviceMock::NetDeviceMock(std::uint16_t transmitBufferSize, std::uint16_t receiveBufferSize)
+        : transmitSize(transmitBufferSize), receiveSize(receiveBufferSize)
+    {
+    }
+
+    void NetDeviceMock::writeSocketModeRegister(SocketHandle s, std::uint8_t value)
+    {
+        mock("Device").actualCall("writeSocketModeRegister").withParameter("socket", s.value()).withParameter("value", value);
+    }
+
+    void NetDeviceMock::writeSocketSourcePort(SocketHandle s, std::uint16_t value)
+    {
+        mock("Device").actualCall("writeSocketSourcePort").withParameter("socket", s.value()).withParameter("value", value);
+    }
+
+    void NetDeviceMock::writeSocketInterruptRegister(SocketHandle s, SocketInterrupt value)
+    {
+        mock("Device")
+            .actualCall("writeSocketInterruptRegister")
+            .withParameter("socket", s.value())
+            .withParameter("value", value.value());
+    }
+
+    SocketInterrupt NetDeviceMock::readSocketInterruptRegister(SocketHandle s)
+    {
+        const auto value =
+            mock("Device").actualCall("readSocketInterruptRegister").withParameter("socket", s.value()).returnUnsignedIntValue();
+        return SocketInterrupt(value);
+    }
+
+    std::uint8_t NetDeviceMock::readInterruptRegister()
+    {
+        return mock("Device").actualCall("readInterruptRegister").returnUnsignedIntValue();
+    }
+
+    void NetDeviceMock::writeInterruptMaskRegister(std::uint8_t value)
+    {
+        mock("Device").actualCall("writeInterruptMaskRegister").withParameter("value", value);
+    }
+
+    void NetDeviceMock::executeSocketCommand(SocketHandle s, SocketCommand cmd)
+    {
+        mock("Device")
+            .actualCall("executeSocketCommand")
+            .withParameter("socket", s.value())
+            .withParameter("value", static_cast<std::uint8_t>(cmd));
+    }
+
+    SocketStatus NetDeviceMock::readSocketStatusRegister(SocketHandle s)
+    {
+        return static_cast<SocketStatus>(
+            mock("Device").actualCall("readSocketStatusRegister").withParameter("socket", s.value()).returnUnsignedIntValue());
+    }
+
+    SocketSnapshot NetDeviceMock::readSocketState(SocketHandle s)
+    {
+        socketstate::Block block{};
+        mock("Device").actualCall("readSocketState").withParameter("socket", s.value()).withOutputParameter("block", block.data());
+        return socketstate::decode(block);
+    }
+
+    std::uint16_t NetDeviceMock::getTransmitFreeSize(SocketHandle s)
+    {
+        return mock("Device").actualCall("getTransmitFreeSize").withParameter("socket", s.value()).returnUnsignedIntValue();
+    }
+
+    std::uint16_t NetDeviceMock::getReceiveFreeSize(SocketHandle s)
+    {
+        return mock("Device").actualCall("getReceiveFreeSize").withParameter("socket", s.value()).returnUnsignedIntValue();
+    }
+
+    void NetDeviceMock::sendData(SocketHandle s, const std::span<const std::uint8_t> buffer)
+    {
+        mock("Device")
+            .actualCall("sendData")
+            .withParameter("socket", s.value())
+            .withMemoryBufferParameter("buffer", buffer.data(), buffer.size())
+            .withParameter("size", buffer.size());
+    }
+
+    void NetDeviceMock::sendData(SocketHandle s, std::span<const std::span<const std::uint8_t>> segments)
+    {
+        std::size_t size{0};
+
+        for (const auto& segment : segments)
+        {
+            size += segment.size();
+        }
+
+        mock("Device")
+            .actualCall("sendSegments")
+            .withParameter("socket", s.value())
+            .withParameter("segments", segments.size())
+            .withParameter("size", size);
+    }
+
+    std::uint16_t NetDeviceMock::receiveData(SocketHandle s, std::span<std::uint8_t> buffer)
+    {
+        return mock("Device")
+            .actualCall("receiveData")
+            .withParameter("socket", s.value())
+            .withOutputParameter("buffer", buffer.data())
+            .withParameter("size", buffer.size())
+            .returnUnsignedIntValue();
+    }
+
+    std::uint16_t NetDeviceMock::readTransmitPointer(SocketHandle s)
+    {
+        return mock("Device").actualCall("readTransmitPointer").withParameter("socket", s.value()).returnUnsignedIntValue();
+    }
+
+    void NetDeviceMock::writeTransmitPointer(SocketHandle s, std::uint16_t value)
+    {
+        mock("Device").actualCall("writeTransmitPointer").withParameter("socket", s.value()).withParameter("value", value);
+    }
+
+    std::uint16_t NetDeviceMock::readReceivePointer(SocketHandle s)
+    {
+        return mock("Device").actualCall("readReceivePointer").withParameter("socket", s.value()).returnUnsignedIntValue();
+    }
+
+    void NetDeviceMock::writeReceivePointer(SocketHandle s, std::uint16_t value)
+    {
+        mock("Device").actualCall("writeReceivePointer").withParameter("socket", s.value()).withParameter("value", value);
+    }
+
+    void NetDeviceMock::writeTransmitBuffer(SocketHandle s, std::uint16_t pointer, std::span<const std::uint8_t> buffer)
+    {
+        mock("Device")
+            .actualCall("writeTransmitBuffer")
+            .withParameter("socket", s.value())
+            .withParameter("pointer", pointer)
+            .withMemoryBufferParameter("buffer", buffer.data(), buffer.size())
+            .withParameter("size", buffer.size());
+    }
+
+    void NetDeviceMock::readReceiveBuffer(SocketHandle s, std::uint16_t pointer, std::span<std::uint8_t> buffer)
+    {
+        mock("Device")
+            .actualCall("readReceiveBuffer")
+            .withParameter("socket", s.value())
+            .withParameter("pointer", pointer)
+            .withOutputParameter("buffer", buffer.data())
+            .withParameter("size", buffer.size());
+    }
+
+    void NetDeviceMock::setDestAddress(SocketHandle s, NetAddress<4> addr, std::uint16_t port)
+    {
+        mock("Device")
+            .actualCall("setDestAddress")
+            .withParameter("socket", s.value())
+            .withMemoryBufferParameter("buffer", addr.data(), addr.size())
+            .withParameter("port", port);
+    }
+
+    std::uint16_t NetDeviceMock::getTransmitBufferSize([[maybe_unused]] SocketHandle s) const noexcept
+    {
+        return transmitSize;
+    }
+
+    std::uint16_t NetDeviceMock::getReceiveBufferSize([[maybe_unused]] SocketHandle s) const noexcept
+    {
+        return receiveSize;
+    }
+
+    std::uint16_t NetDeviceMock::getReceiveBufferAddress(SocketHandle s) const noexcept
+    {
+        constexpr std::uint16_t baseAddress{0x6000};
+        return baseAddress + (receiveSize * s.value());
+    }
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "NetDevice.h"
+
+namespace eth::test
+{
+
+    class NetDeviceMock : public NetDevice
+    {
+    public:
+        explicit NetDeviceMock(std::uint16_t transmitBufferSize = 2048, std::uint16_t receiveBufferSize = 2048);
+
+
+        std::uint8_t getSocketCount() const noexcept override
+        {
+            return supportedSockets;
+        }
+
+        void executeSocketCommand(SocketHandle s, SocketCommand cmd) override;
+
+        void writeSocketModeRegister(SocketHandle s, std::uint8_t value) override;
+        void writeSocketSourcePort(SocketHandle s, std::uint16_t value) override;
+
+        void writeSocketInterruptRegister(SocketHandle s, SocketInterrupt value) override;
+        SocketInterrupt readSocketInterruptRegister(SocketHandle s) override;
+
+        std::uint8_t readInterruptRegister() override;
+        void writeInterruptMaskRegister(std::uint8_t value) override;
+
+        SocketStatus readSocketStatusRegister(SocketHandle s) override;
+        SocketSnapshot readSocketState(SocketHandle s) override;
+
+        std::uint16_t getTransmitFreeSize(SocketHandle s) override;
+        std::uint16_t getReceiveFreeSize(SocketHandle s) override;
+
+        void sendData(SocketHandle s, const std::span<const std::uint8_t> buffer) override;
+        void sendData(SocketHandle s, std::span<const std::span<const std::uint8_t>> segments) override;
+        std::uint16_t receiveData(SocketHandle s, std::span<std::uint8_t> buffer) override;
+
+        std::uint16_t readTransmitPointer(SocketHandle s) override;
+        void writeTransmitPointer(SocketHandle s, std::uint16_t value) override;
+        std::uint16_t readReceivePointer(SocketHandle s) override;
+        void writeReceivePointer(SocketHandle s, std::uint16_t value) override;
+
+        void writeTransmitBuffer(SocketHandle s, std::uint16_t pointer, std::span<const std::uint8_t> buffer) override;
+        void readReceiveBuffer(SocketHandle s, std::uint16_t pointer, std::span<std::uint8_t> buffer) override;
+
+        void setDestAddress(SocketHandle s, NetAddress<4> addr, std::uint16_t port) override;
+
+        std::uint16_t getTransmitBufferSize(SocketHandle s) const noexcept override;
+        std::uint16_t getReceiveBufferSize(SocketHandle s) const noexcept override;
+        std::uint16_t getReceiveBufferAddress(SocketHandle s) const noexcept override;
+
+
+    private:
+        std::uint16_t transmitSize;
+        std::uint16_t receiveSize;
+    };
+
+}
@@ -19,6 +19,7 @@
  */
 
 #include "Platform.h"
+#include <chrono>
 #include <CppUTestExt/MockSupport.h>
 
 namespace platform
@@ -28,4 +29,20 @@ namespace platform
     {
         mock("platform").actualCall("wait").withParameter("timeMs", static_cast<unsigned int>(milliseconds));
     }
+
+    std::uint32_t milliseconds() noexcept
+    {
+        return mock("platform").getData("milliseconds").getUnsignedIntValue();
+    }
+
+    void enableCycleCounter() noexcept
+    {
+        mock("platform").actualCall("enableCycleCounter");
+    }
+
+    std::uint32_t cycles() noexcept
+    {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    }
 }
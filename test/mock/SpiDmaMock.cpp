@@ -0,0 +1,85 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "spi/SpiDma.h"
+#include <CppUTestExt/MockSupport.h>
+
+namespace eth::spi
+{
+
+    SpiDma::SpiDma(SpiWriter& spiWriter, [[maybe_unused]] const DmaConfig& cfg)
+        : writer(spiWriter)
+    {
+    }
+
+    bool SpiDma::startWrite(std::span<const WriteSegment> segments, Callback callback, void* context)
+    {
+        for (const auto& segment : segments)
+        {
+            mock("SpiDma")
+                .actualCall("writeSegment")
+                .withParameter("address", segment.address)
+                .withMemoryBufferParameter("data", segment.data.data(), segment.data.size())
+                .withParameter("size", segment.data.size());
+        }
+
+        completionCallback = callback;
+        completionContext = context;
+        return mock("SpiDma").actualCall("startWrite").returnBoolValueOrDefault(true);
+    }
+
+    bool SpiDma::startRead(std::span<const ReadSegment> segments, Callback callback, void* context)
+    {
+        for (const auto& segment : segments)
+        {
+            mock("SpiDma")
+                .actualCall("readSegment")
+                .withParameter("address", segment.address)
+                .withOutputParameter("data", segment.data.data())
+                .withParameter("size", segment.data.size());
+        }
+
+        completionCallback = callback;
+        completionContext = context;
+        return mock("SpiDma").actualCall("startRead").returnBoolValueOrDefault(true);
+    }
+
+    bool SpiDma::isBusy() const noexcept
+    {
+        return mock("SpiDma").actualCall("isBusy").returnBoolValueOrDefault(false);
+    }
+
+    void SpiDma::onComplete([[maybe_unused]] SPI_HandleTypeDef* hspi)
+    {
+        if (completionCallback != nullptr)
+        {
+            completionCallback(completionContext, true);
+        }
+    }
+
+    void SpiDma::onError([[maybe_unused]] SPI_HandleTypeDef* hspi)
+    {
+        if (completionCallback != nullptr)
+        {
+            completionCallback(completionContext, false);
+        }
+    }
+
+}
@@ -53,4 +53,48 @@ namespace eth::spi
         return mock("SpiWriter").actualCall("read").withParameter("address", address).returnUnsignedIntValue();
     }
 
+    void SpiWriter::writeBlock(std::uint16_t address, std::span<const std::uint8_t> data)
+    {
+        mockutil::incrementCalls("writeBlock::count");
+
+        mock("SpiWriter")
+            .actualCall("writeBlock")
+            .withParameter("address", address)
+            .withMemoryBufferParameter("data", data.data(), data.size())
+            .withParameter("size", data.size());
+    }
+
+    void SpiWriter::readBlock(std::uint16_t address, std::span<std::uint8_t> data)
+    {
+        mockutil::incrementCalls("readBlock::count");
+
+        mock("SpiWriter")
+            .actualCall("readBlock")
+            .withParameter("address", address)
+            .withOutputParameter("data", data.data())
+            .withParameter("size", data.size());
+    }
+
+    void SpiWriter::writeFrame(std::span<const std::uint8_t> header, std::span<const std::uint8_t> data)
+    {
+        mockutil::incrementCalls("writeFrame::count");
+
+        mock("SpiWriter")
+            .actualCall("writeFrame")
+            .withMemoryBufferParameter("header", header.data(), header.size())
+            .withMemoryBufferParameter("data", data.data(), data.size())
+            .withParameter("size", data.size());
+    }
+
+    void SpiWriter::readFrame(std::span<const std::uint8_t> header, std::span<std::uint8_t> data)
+    {
+        mockutil::incrementCalls("readFrame::count");
+
+        mock("SpiWriter")
+            .actualCall("readFrame")
+            .withMemoryBufferParameter("header", header.data(), header.size())
+            .withOutputParameter("data", data.data())
+            .withParameter("size", data.size());
+    }
+
 }
@@ -56,6 +56,78 @@ HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef* hspi, std::uint8_t* pData,
     return static_cast<HAL_StatusTypeDef>(rtn);
 }
 
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef* hspi, std::uint8_t* pTxData, std::uint8_t* pRxData, std::uint16_t Size, std::uint32_t Timeout)
+{
+    const auto rtn = mock("HAL_SPI")
+                         .actualCall("HAL_SPI_TransmitReceive")
+                         .withPointerParameter("hspi", hspi)
+                         .withMemoryBufferParameter("pTxData", pTxData, Size)
+                         .withOutputParameter("pRxData", pRxData)
+                         .withParameter("Size", Size)
+                         .withParameter("Timeout", Timeout)
+                         .returnUnsignedIntValueOrDefault(HAL_OK);
+    return static_cast<HAL_StatusTypeDef>(rtn);
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef* hspi, std::uint8_t* pData, std::uint16_t Size)
+{
+    const auto rtn = mock("HAL_SPI")
+                         .actualCall("HAL_SPI_Transmit_DMA")
+                         .withPointerParameter("hspi", hspi)
+                         .withMemoryBufferParameter("pData", pData, Size)
+                         .withParameter("Size", Size)
+                         .returnUnsignedIntValueOrDefault(HAL_OK);
+    return static_cast<HAL_StatusTypeDef>(rtn);
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef* hspi, std::uint8_t* pTxData, std::uint8_t* pRxData, std::uint16_t Size)
+{
+    const auto rtn = mock("HAL_SPI")
+                         .actualCall("HAL_SPI_TransmitReceive_DMA")
+                         .withPointerParameter("hspi", hspi)
+                         .withMemoryBufferParameter("pTxData", pTxData, Size)
+                         .withOutputParameter("pRxData", pRxData)
+                         .withParameter("Size", Size)
+                         .returnUnsignedIntValueOrDefault(HAL_OK);
+    return static_cast<HAL_StatusTypeDef>(rtn);
+}
+
+__attribute__((weak)) void HAL_SPI_TxCpltCallback([[maybe_unused]] SPI_HandleTypeDef* hspi)
+{
+}
+
+__attribute__((weak)) void HAL_SPI_TxRxCpltCallback([[maybe_unused]] SPI_HandleTypeDef* hspi)
+{
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef* hdma)
+{
+    const auto rtn = mock("HAL_DMA")
+                         .actualCall("HAL_DMA_Init")
+                         .withPointerParameter("hdma", hdma)
+                         .withPointerParameter("hdma.instance", hdma->Instance)
+                         .withParameter("hdma.channel", hdma->Init.Channel)
+                         .withParameter("hdma.direction", hdma->Init.Direction)
+                         .returnUnsignedIntValueOrDefault(HAL_OK);
+    return static_cast<HAL_StatusTypeDef>(rtn);
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef* hdma)
+{
+    mock("HAL_DMA").actualCall("HAL_DMA_IRQHandler").withPointerParameter("hdma", hdma);
+
+    auto* spi = static_cast<SPI_HandleTypeDef*>(hdma->Parent);
+
+    if (hdma->Init.Direction == DMA_PERIPH_TO_MEMORY)
+    {
+        HAL_SPI_TxRxCpltCallback(spi);
+    }
+    else
+    {
+        HAL_SPI_TxCpltCallback(spi);
+    }
+}
+
 void HAL_GPIO_Init(GPIO_TypeDef* GPIOx, GPIO_InitTypeDef* GPIO_Init)
 {
     mock("HAL_GPIO")
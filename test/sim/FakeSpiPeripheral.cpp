@@ -0,0 +1,102 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FakeSpiPeripheral.h"
+#include "spi/Packet.h"
+#include <stm32f4xx_hal.h>
+
+namespace eth::sim
+{
+
+    FakeSpiPeripheral::DataRegister& FakeSpiPeripheral::DataRegister::operator=(std::uint32_t value)
+    {
+        peripheral.shift(static_cast<std::uint8_t>(value));
+        return *this;
+    }
+
+    FakeSpiPeripheral::DataRegister::operator std::uint32_t() const
+    {
+        return peripheral.received;
+    }
+
+    FakeSpiPeripheral::SetResetRegister& FakeSpiPeripheral::SetResetRegister::operator=(std::uint32_t value)
+    {
+        peripheral.setReset(value);
+        return *this;
+    }
+
+
+    FakeSpiPeripheral::FakeSpiPeripheral(W5100Simulator& target, std::uint16_t slaveSelectPin)
+        : spi{0, SPI_SR_TXE | SPI_SR_RXNE, DataRegister{*this}}, gpio{SetResetRegister{*this}},
+          simulator(target), pin(slaveSelectPin), selected(false), received(0), transmitted{}
+    {
+    }
+
+    bool FakeSpiPeripheral::isSelected() const noexcept
+    {
+        return selected;
+    }
+
+    const std::vector<std::vector<std::uint8_t>>& FakeSpiPeripheral::frames() const noexcept
+    {
+        return transmitted;
+    }
+
+    void FakeSpiPeripheral::shift(std::uint8_t value)
+    {
+        received = 0;
+
+        if ((selected == false) || ((spi.CR1 & SPI_CR1_SPE) == 0))
+        {
+            return;
+        }
+
+        auto& frame = transmitted.back();
+        frame.push_back(value);
+
+        if (frame.size() == spi::packetSize)
+        {
+            const auto address = static_cast<std::uint16_t>((frame[1] << 8) | frame[2]);
+
+            if (frame[0] == static_cast<std::uint8_t>(spi::OpCode::write))
+            {
+                simulator.write(address, value);
+            }
+            else if (frame[0] == static_cast<std::uint8_t>(spi::OpCode::read))
+            {
+                received = simulator.read(address);
+            }
+        }
+    }
+
+    void FakeSpiPeripheral::setReset(std::uint32_t value)
+    {
+        if ((value & (std::uint32_t{pin} << 16)) != 0)
+        {
+            selected = true;
+            transmitted.emplace_back();
+        }
+        else if ((value & pin) != 0)
+        {
+            selected = false;
+        }
+    }
+
+}
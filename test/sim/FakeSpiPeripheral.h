@@ -0,0 +1,102 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "W5100Simulator.h"
+#include <cstdint>
+#include <vector>
+
+namespace eth::sim
+{
+
+    class FakeSpiPeripheral
+    {
+    public:
+        class DataRegister
+        {
+        public:
+            explicit DataRegister(FakeSpiPeripheral& owner)
+                : peripheral(owner)
+            {
+            }
+
+            DataRegister& operator=(std::uint32_t value);
+            operator std::uint32_t() const;
+
+        private:
+            FakeSpiPeripheral& peripheral;
+        };
+
+        class SetResetRegister
+        {
+        public:
+            explicit SetResetRegister(FakeSpiPeripheral& owner)
+                : peripheral(owner)
+            {
+            }
+
+            SetResetRegister& operator=(std::uint32_t value);
+
+        private:
+            FakeSpiPeripheral& peripheral;
+        };
+
+        struct SpiRegisters
+        {
+            std::uint32_t CR1;
+            std::uint32_t SR;
+            DataRegister DR;
+        };
+
+        struct GpioRegisters
+        {
+            SetResetRegister BSRR;
+        };
+
+
+        FakeSpiPeripheral(W5100Simulator& target, std::uint16_t slaveSelectPin);
+        FakeSpiPeripheral(const FakeSpiPeripheral&) = delete;
+
+
+        bool isSelected() const noexcept;
+        const std::vector<std::vector<std::uint8_t>>& frames() const noexcept;
+
+
+        FakeSpiPeripheral& operator=(const FakeSpiPeripheral&) = delete;
+
+
+        SpiRegisters spi;
+        GpioRegisters gpio;
+
+
+    private:
+        void shift(std::uint8_t value);
+        void setReset(std::uint32_t value);
+
+
+        W5100Simulator& simulator;
+        std::uint16_t pin;
+        bool selected;
+        std::uint8_t received;
+        std::vector<std::vector<std::uint8_t>> transmitted;
+    };
+
+}
@@ -0,0 +1,110 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MqttBroker.h"
+#include <iterator>
+
+namespace eth::sim
+{
+    namespace
+    {
+        constexpr std::uint8_t publishType{3};
+        constexpr std::uint8_t qosMask{0x06};
+        constexpr std::uint8_t dupMask{0x08};
+
+        std::uint16_t readWord(const std::vector<std::uint8_t>& data, std::size_t offset)
+        {
+            return static_cast<std::uint16_t>((data[offset] << 8) | data[offset + 1]);
+        }
+    }
+
+
+    MqttBroker::MqttBroker(W5100Simulator& sim, SocketHandle s)
+        : simulator(sim), handle(s)
+    {
+    }
+
+    std::vector<MqttBroker::Packet> MqttBroker::receive()
+    {
+        const auto data = simulator.takeTransmitted(handle);
+        std::vector<Packet> packets;
+        std::size_t offset{0};
+
+        while (offset < data.size())
+        {
+            const auto header = data[offset++];
+            std::size_t length{0};
+            std::size_t multiplier{1};
+            std::uint8_t encoded{0};
+
+            do
+            {
+                encoded = data[offset++];
+                length += (encoded & 0x7fu) * multiplier;
+                multiplier *= 128;
+            } while ((encoded & 0x80u) != 0);
+
+            const auto begin = std::next(data.cbegin(), static_cast<std::ptrdiff_t>(offset));
+            packets.push_back({static_cast<std::uint8_t>(header >> 4), static_cast<std::uint8_t>(header & 0x0f),
+                               {begin, std::next(begin, static_cast<std::ptrdiff_t>(length))}});
+            offset += length;
+        }
+
+        return packets;
+    }
+
+    MqttBroker::Publish MqttBroker::decodePublish(const Packet& packet)
+    {
+        if (packet.type != publishType)
+        {
+            return {};
+        }
+
+        const auto topicSize = readWord(packet.body, 0);
+        const auto topicBegin = std::next(packet.body.cbegin(), 2);
+        const auto topicEnd = std::next(topicBegin, topicSize);
+        const bool hasId = ((packet.flags & qosMask) != 0);
+        const std::uint16_t packetId = hasId ? readWord(packet.body, 2u + topicSize) : 0;
+        const auto payloadBegin = std::next(topicEnd, hasId ? 2 : 0);
+
+        return {{topicBegin, topicEnd}, packetId, {payloadBegin, packet.body.cend()}, (packet.flags & dupMask) != 0};
+    }
+
+    void MqttBroker::connack(bool sessionPresent, std::uint8_t returnCode)
+    {
+        reply({0x20, 0x02, static_cast<std::uint8_t>(sessionPresent ? 0x01 : 0x00), returnCode});
+    }
+
+    void MqttBroker::puback(std::uint16_t packetId)
+    {
+        reply({0x40, 0x02, static_cast<std::uint8_t>(packetId >> 8), static_cast<std::uint8_t>(packetId)});
+    }
+
+    void MqttBroker::pingresp()
+    {
+        reply({0xd0, 0x00});
+    }
+
+    void MqttBroker::reply(const std::vector<std::uint8_t>& packet)
+    {
+        simulator.injectReceive(handle, packet);
+    }
+
+}
@@ -0,0 +1,74 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "W5100Simulator.h"
+#include "SocketHandle.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace eth::sim
+{
+
+    class MqttBroker
+    {
+    public:
+        struct Packet
+        {
+            std::uint8_t type;
+            std::uint8_t flags;
+            std::vector<std::uint8_t> body;
+        };
+
+        struct Publish
+        {
+            std::string topic;
+            std::uint16_t packetId;
+            std::string payload;
+            bool dup;
+        };
+
+
+        MqttBroker(W5100Simulator& sim, SocketHandle s);
+        MqttBroker(const MqttBroker&) = delete;
+
+
+        std::vector<Packet> receive();
+        static Publish decodePublish(const Packet& packet);
+
+        void connack(bool sessionPresent, std::uint8_t returnCode = 0);
+        void puback(std::uint16_t packetId);
+        void pingresp();
+
+
+        MqttBroker& operator=(const MqttBroker&) = delete;
+
+
+    private:
+        void reply(const std::vector<std::uint8_t>& packet);
+
+
+        W5100Simulator& simulator;
+        SocketHandle handle;
+    };
+
+}
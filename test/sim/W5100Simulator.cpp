@@ -0,0 +1,430 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "W5100Simulator.h"
+#include "SocketCommand.h"
+#include <algorithm>
+
+namespace eth::sim
+{
+
+    namespace
+    {
+        constexpr std::uint16_t modeRegister{0x0000};
+        constexpr std::uint16_t interruptRegister{0x0015};
+        constexpr std::uint16_t receiveMemorySize{0x001a};
+        constexpr std::uint16_t transmitMemorySize{0x001b};
+
+        constexpr std::uint16_t socketRegisterBase{0x0400};
+        constexpr std::uint16_t socketRegisterSize{0x0100};
+        constexpr std::uint16_t transmitMemoryBase{0x4000};
+        constexpr std::uint16_t receiveMemoryBase{0x6000};
+
+        constexpr std::uint8_t socketMode{0x00};
+        constexpr std::uint8_t socketCommand{0x01};
+        constexpr std::uint8_t socketInterrupt{0x02};
+        constexpr std::uint8_t socketStatus{0x03};
+        constexpr std::uint8_t transmitFreeSize{0x20};
+        constexpr std::uint8_t transmitReadPointer{0x22};
+        constexpr std::uint8_t transmitWritePointer{0x24};
+        constexpr std::uint8_t receivedSize{0x26};
+        constexpr std::uint8_t receiveReadPointer{0x28};
+
+        constexpr std::uint8_t resetBit{0x80};
+        constexpr std::uint8_t defaultMemorySize{0x55};
+
+        constexpr std::uint8_t interruptConnect{0x01};
+        constexpr std::uint8_t interruptDisconnect{0x02};
+        constexpr std::uint8_t interruptReceive{0x04};
+        constexpr std::uint8_t interruptSend{0x10};
+
+        constexpr std::uint8_t bitsPerFrame{32};
+
+
+        constexpr std::uint16_t socketRegister(SocketHandle s, std::uint8_t reg)
+        {
+            return socketRegisterBase + (s.value() * socketRegisterSize) + reg;
+        }
+
+        constexpr bool isSocketRegister(std::uint16_t address)
+        {
+            return (address >= socketRegisterBase) && (address < (socketRegisterBase + supportedSockets * socketRegisterSize));
+        }
+
+        constexpr std::uint16_t bufferSize(std::uint8_t memorySize, SocketHandle s)
+        {
+            return 1024 << ((memorySize >> (s.value() * 2)) & 0x03);
+        }
+
+        SocketStatus statusAfterOpen(std::uint8_t mode)
+        {
+            switch (mode & 0x0f)
+            {
+                case 0x01:
+                    return SocketStatus::init;
+                case 0x02:
+                    return SocketStatus::udp;
+                case 0x04:
+                    return SocketStatus::macRaw;
+                default:
+                    return SocketStatus::closed;
+            }
+        }
+    }
+
+
+    W5100Simulator::W5100Simulator(std::uint32_t spiClockHz)
+        : spiClock(spiClockHz)
+    {
+        reset();
+    }
+
+    void W5100Simulator::write(std::uint16_t address, std::uint8_t data)
+    {
+        countFrame();
+
+        if (address == modeRegister && (data & resetBit) != 0)
+        {
+            reset();
+        }
+        else if (isSocketRegister(address))
+        {
+            const SocketHandle s{static_cast<SocketHandle::value_type>((address - socketRegisterBase) / socketRegisterSize)};
+            writeSocketRegister(s, address & 0xff, data);
+        }
+        else if (address < memory.size())
+        {
+            memory[address] = data;
+        }
+    }
+
+    std::uint8_t W5100Simulator::read(std::uint16_t address)
+    {
+        countFrame();
+
+        if (address == interruptRegister)
+        {
+            std::uint8_t value{0};
+
+            for (std::uint8_t i = 0; i < supportedSockets; ++i)
+            {
+                if (memory[socketRegister(SocketHandle{i}, socketInterrupt)] != 0)
+                {
+                    value |= (1 << i);
+                }
+            }
+            return value;
+        }
+
+        if (isSocketRegister(address))
+        {
+            updateSocketRegisters(SocketHandle{static_cast<SocketHandle::value_type>((address - socketRegisterBase) / socketRegisterSize)});
+        }
+
+        return (address < memory.size()) ? memory[address] : 0;
+    }
+
+    void W5100Simulator::writeBlock(std::uint16_t address, std::span<const std::uint8_t> data)
+    {
+        for (const auto value : data)
+        {
+            write(address++, value);
+        }
+    }
+
+    void W5100Simulator::readBlock(std::uint16_t address, std::span<std::uint8_t> data)
+    {
+        std::generate(data.begin(), data.end(), [this, &address]
+                      { return read(address++); });
+    }
+
+    SocketStatus W5100Simulator::status(SocketHandle s) const
+    {
+        return static_cast<SocketStatus>(memory[socketRegister(s, socketStatus)]);
+    }
+
+    void W5100Simulator::acceptConnection(SocketHandle s)
+    {
+        if (status(s) == SocketStatus::listen)
+        {
+            setStatus(s, SocketStatus::established);
+            raiseInterrupt(s, interruptConnect);
+        }
+    }
+
+    void W5100Simulator::closeByPeer(SocketHandle s)
+    {
+        if (status(s) == SocketStatus::established)
+        {
+            setStatus(s, SocketStatus::closeWait);
+            raiseInterrupt(s, interruptDisconnect);
+        }
+    }
+
+    void W5100Simulator::stallPeer(SocketHandle s)
+    {
+        sockets[s.value()].stalled = true;
+    }
+
+    void W5100Simulator::resumePeer(SocketHandle s)
+    {
+        sockets[s.value()].stalled = false;
+        transmitPending(s);
+
+        if (status(s) == SocketStatus::finWait)
+        {
+            setStatus(s, SocketStatus::closed);
+            raiseInterrupt(s, interruptDisconnect);
+        }
+    }
+
+    bool W5100Simulator::injectReceive(SocketHandle s, std::span<const std::uint8_t> data)
+    {
+        auto& state = sockets[s.value()];
+        const auto size = receiveBufferSize(s);
+        const std::uint16_t used = state.receiveWritePointer - readWord(socketRegister(s, receiveReadPointer));
+
+        if (data.size() > static_cast<std::size_t>(size - used))
+        {
+            return false;
+        }
+
+        const auto base = receiveBufferBase(s);
+
+        for (const auto value : data)
+        {
+            memory[base + (state.receiveWritePointer & (size - 1))] = value;
+            ++state.receiveWritePointer;
+        }
+
+        raiseInterrupt(s, interruptReceive);
+        return true;
+    }
+
+    std::vector<std::uint8_t> W5100Simulator::takeTransmitted(SocketHandle s)
+    {
+        std::vector<std::uint8_t> data;
+        data.swap(sockets[s.value()].transmitted);
+        return data;
+    }
+
+    std::size_t W5100Simulator::sendCommands(SocketHandle s) const
+    {
+        return sockets[s.value()].sendCommands;
+    }
+
+    SpiStatistics W5100Simulator::statistics() const noexcept
+    {
+        return {frameCount,
+                bitCount / 8,
+                frameCount * 2,
+                (bitCount * 1'000'000'000) / spiClock};
+    }
+
+    void W5100Simulator::resetStatistics() noexcept
+    {
+        frameCount = 0;
+        bitCount = 0;
+    }
+
+    void W5100Simulator::countFrame() noexcept
+    {
+        ++frameCount;
+        bitCount += bitsPerFrame;
+    }
+
+    void W5100Simulator::reset()
+    {
+        memory.fill(0);
+        memory[receiveMemorySize] = defaultMemorySize;
+        memory[transmitMemorySize] = defaultMemorySize;
+        sockets.fill({});
+    }
+
+    void W5100Simulator::writeSocketRegister(SocketHandle s, std::uint8_t reg, std::uint8_t data)
+    {
+        const auto address = socketRegister(s, reg);
+
+        switch (reg)
+        {
+            case socketCommand:
+                execute(s, data);
+                break;
+            case socketInterrupt:
+                memory[address] &= ~data;
+                break;
+            case socketStatus:
+            case transmitFreeSize:
+            case transmitFreeSize + 1:
+            case transmitReadPointer:
+            case transmitReadPointer + 1:
+            case receivedSize:
+            case receivedSize + 1:
+                break;
+            default:
+                memory[address] = data;
+                break;
+        }
+    }
+
+    void W5100Simulator::updateSocketRegisters(SocketHandle s)
+    {
+        const auto& state = sockets[s.value()];
+        const std::uint16_t transmitUsed = readWord(socketRegister(s, transmitWritePointer)) - state.transmitReadPointer;
+        const std::uint16_t received = state.receiveWritePointer - readWord(socketRegister(s, receiveReadPointer));
+
+        writeWord(socketRegister(s, transmitFreeSize), transmitBufferSize(s) - transmitUsed);
+        writeWord(socketRegister(s, transmitReadPointer), state.transmitReadPointer);
+        writeWord(socketRegister(s, receivedSize), received);
+    }
+
+    void W5100Simulator::execute(SocketHandle s, std::uint8_t command)
+    {
+        auto& state = sockets[s.value()];
+
+        switch (static_cast<SocketCommand>(command))
+        {
+            case SocketCommand::open:
+                state.transmitReadPointer = 0;
+                state.receiveWritePointer = 0;
+                writeWord(socketRegister(s, transmitWritePointer), 0);
+                writeWord(socketRegister(s, receiveReadPointer), 0);
+                setStatus(s, statusAfterOpen(memory[socketRegister(s, socketMode)]));
+                break;
+            case SocketCommand::listen:
+                if (status(s) == SocketStatus::init)
+                {
+                    setStatus(s, SocketStatus::listen);
+                }
+                break;
+            case SocketCommand::connect:
+                if (status(s) == SocketStatus::init)
+                {
+                    setStatus(s, SocketStatus::established);
+                    raiseInterrupt(s, interruptConnect);
+                }
+                break;
+            case SocketCommand::disconnect:
+                if (state.stalled == true)
+                {
+                    setStatus(s, SocketStatus::finWait);
+                }
+                else
+                {
+                    setStatus(s, SocketStatus::closed);
+                    raiseInterrupt(s, interruptDisconnect);
+                }
+                break;
+            case SocketCommand::close:
+                setStatus(s, SocketStatus::closed);
+                break;
+            case SocketCommand::send:
+            case SocketCommand::sendMac:
+            case SocketCommand::sendKeep:
+                ++state.sendCommands;
+
+                if (state.stalled == false)
+                {
+                    transmitPending(s);
+                }
+                break;
+            case SocketCommand::receive:
+                if (state.receiveWritePointer != readWord(socketRegister(s, receiveReadPointer)))
+                {
+                    raiseInterrupt(s, interruptReceive);
+                }
+                break;
+            default:
+                break;
+        }
+
+        memory[socketRegister(s, socketCommand)] = static_cast<std::uint8_t>(SocketCommand::executed);
+    }
+
+    void W5100Simulator::setStatus(SocketHandle s, SocketStatus value)
+    {
+        memory[socketRegister(s, socketStatus)] = static_cast<std::uint8_t>(value);
+    }
+
+    void W5100Simulator::raiseInterrupt(SocketHandle s, std::uint8_t mask)
+    {
+        memory[socketRegister(s, socketInterrupt)] |= mask;
+    }
+
+    void W5100Simulator::transmitPending(SocketHandle s)
+    {
+        auto& state = sockets[s.value()];
+        const auto writePointer = readWord(socketRegister(s, transmitWritePointer));
+        const auto size = transmitBufferSize(s);
+        const auto base = transmitBufferBase(s);
+
+        while (state.transmitReadPointer != writePointer)
+        {
+            state.transmitted.push_back(memory[base + (state.transmitReadPointer & (size - 1))]);
+            ++state.transmitReadPointer;
+        }
+
+        raiseInterrupt(s, interruptSend);
+    }
+
+    std::uint16_t W5100Simulator::readWord(std::uint16_t address) const
+    {
+        return static_cast<std::uint16_t>((memory[address] << 8) | memory[address + 1]);
+    }
+
+    void W5100Simulator::writeWord(std::uint16_t address, std::uint16_t value)
+    {
+        memory[address] = static_cast<std::uint8_t>(value >> 8);
+        memory[address + 1] = static_cast<std::uint8_t>(value);
+    }
+
+    std::uint16_t W5100Simulator::transmitBufferSize(SocketHandle s) const
+    {
+        return bufferSize(memory[transmitMemorySize], s);
+    }
+
+    std::uint16_t W5100Simulator::receiveBufferSize(SocketHandle s) const
+    {
+        return bufferSize(memory[receiveMemorySize], s);
+    }
+
+    std::uint16_t W5100Simulator::transmitBufferBase(SocketHandle s) const
+    {
+        std::uint16_t base{transmitMemoryBase};
+
+        for (std::uint8_t i = 0; i < s.value(); ++i)
+        {
+            base += transmitBufferSize(SocketHandle{i});
+        }
+        return base;
+    }
+
+    std::uint16_t W5100Simulator::receiveBufferBase(SocketHandle s) const
+    {
+        std::uint16_t base{receiveMemoryBase};
+
+        for (std::uint8_t i = 0; i < s.value(); ++i)
+        {
+            base += receiveBufferSize(SocketHandle{i});
+        }
+        return base;
+    }
+
+}
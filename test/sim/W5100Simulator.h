@@ -0,0 +1,109 @@
+/*
+ * Stm32 Eth - Ethernet connectivity for Stm32
+ * Copyright (C) 2016-2026  offa
+ *
+ * This file is part of Stm32 Eth.
+ *
+ * Stm32 Eth is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Stm32 Eth is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Stm32 Eth.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "SocketHandle.h"
+#include "SocketStatus.h"
+#include <array>
+#include <vector>
+#include <span>
+#include <cstddef>
+#include <cstdint>
+
+namespace eth::sim
+{
+
+    struct SpiStatistics
+    {
+        std::uint64_t frames;
+        std::uint64_t bytes;
+        std::uint64_t chipSelectToggles;
+        std::uint64_t wireTimeNs;
+    };
+
+
+    class W5100Simulator
+    {
+    public:
+        static inline constexpr std::uint32_t defaultSpiClock{10'000'000};
+
+
+        explicit W5100Simulator(std::uint32_t spiClockHz = defaultSpiClock);
+        W5100Simulator(const W5100Simulator&) = delete;
+
+
+        void write(std::uint16_t address, std::uint8_t data);
+        std::uint8_t read(std::uint16_t address);
+
+        void writeBlock(std::uint16_t address, std::span<const std::uint8_t> data);
+        void readBlock(std::uint16_t address, std::span<std::uint8_t> data);
+
+        SocketStatus status(SocketHandle s) const;
+        void acceptConnection(SocketHandle s);
+        void closeByPeer(SocketHandle s);
+        void stallPeer(SocketHandle s);
+        void resumePeer(SocketHandle s);
+        bool injectReceive(SocketHandle s, std::span<const std::uint8_t> data);
+        std::vector<std::uint8_t> takeTransmitted(SocketHandle s);
+        std::size_t sendCommands(SocketHandle s) const;
+
+        SpiStatistics statistics() const noexcept;
+        void resetStatistics() noexcept;
+
+
+        W5100Simulator& operator=(const W5100Simulator&) = delete;
+
+
+    private:
+        struct SocketState
+        {
+            std::uint16_t transmitReadPointer;
+            std::uint16_t receiveWritePointer;
+            std::size_t sendCommands;
+            std::vector<std::uint8_t> transmitted;
+            bool stalled;
+        };
+
+        void countFrame() noexcept;
+        void reset();
+        void writeSocketRegister(SocketHandle s, std::uint8_t reg, std::uint8_t data);
+        void updateSocketRegisters(SocketHandle s);
+        void execute(SocketHandle s, std::uint8_t command);
+        void setStatus(SocketHandle s, SocketStatus value);
+        void raiseInterrupt(SocketHandle s, std::uint8_t mask);
+        void transmitPending(SocketHandle s);
+
+        std::uint16_t readWord(std::uint16_t address) const;
+        void writeWord(std::uint16_t address, std::uint16_t value);
+        std::uint16_t transmitBufferSize(SocketHandle s) const;
+        std::uint16_t receiveBufferSize(SocketHandle s) const;
+        std::uint16_t transmitBufferBase(SocketHandle s) const;
+        std::uint16_t receiveBufferBase(SocketHandle s) const;
+
+
+        std::array<std::uint8_t, 0x8000> memory{};
+        std::array<SocketState, supportedSockets> sockets{};
+        std::uint32_t spiClock;
+        std::uint64_t frameCount{0};
+        std::uint64_t bitCount{0};
+    };
+
+}